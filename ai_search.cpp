@@ -0,0 +1,250 @@
+#include "ai_search.h"
+#include "battle.h"
+#include <algorithm>
+
+namespace {
+
+// Bounds of BattleModel::evaluate
+constexpr float VALUE_MIN = -1.0f;
+constexpr float VALUE_MAX = 1.0f;
+
+// Nodes between clock checks
+constexpr long long CLOCK_CHECK_INTERVAL = 64;
+
+// Decision nodes are hashed apart from the same state before its status check
+constexpr uint64_t DECISION_NODE_KEY = 0xD1B54A32D192ED03ULL;
+
+// The table stores values from the player's side so policies for both sides can share it
+void toTable(BattleSide self, float& value, BoundType& bound) {
+    if (self == BattleSide::PLAYER) {
+        return;
+    }
+    value = -value;
+    if (bound == BoundType::LOWER) {
+        bound = BoundType::UPPER;
+    } else if (bound == BoundType::UPPER) {
+        bound = BoundType::LOWER;
+    }
+}
+
+} // namespace
+
+// Constructor
+ExpectiminimaxPolicy::ExpectiminimaxPolicy(const SearchBudget& searchBudget, std::shared_ptr<TranspositionTable> sharedTable)
+    : budget(searchBudget), table(sharedTable), model(nullptr), self(BattleSide::ENEMY), aborted(false) {
+    if (!table) {
+        table = std::make_shared<TranspositionTable>();
+    }
+}
+
+// Change the search limits
+void ExpectiminimaxPolicy::setBudget(const SearchBudget& newBudget) {
+    budget = newBudget;
+}
+
+// Get statistics of the most recent decision
+const SearchStats& ExpectiminimaxPolicy::getLastStats() const {
+    return stats;
+}
+
+// Get the transposition table
+std::shared_ptr<TranspositionTable> ExpectiminimaxPolicy::getTable() const {
+    return table;
+}
+
+// Pick an action with iterative deepening
+BattleDecision ExpectiminimaxPolicy::decide(const Battle& battle, BattleSide side) {
+    auto start = std::chrono::steady_clock::now();
+    BattleModel battleModel(battle);
+    BattleState root = battleModel.initialState(side);
+
+    model = &battleModel;
+    self = side;
+    deadline = start + std::chrono::milliseconds(budget.timeLimitMs);
+    aborted = false;
+    stats = SearchStats();
+    table->newSearch();
+
+    std::vector<int> actions;
+    battleModel.legalActions(root, side, actions);
+    if (actions.empty()) {
+        // Nothing to fight or switch with; running away is the only way to end the battle
+        model = nullptr;
+        BattleDecision decision;
+        decision.action = BattleAction::RUN;
+        return decision;
+    }
+
+    int bestAction = actions[0];
+    for (int depth = 1; depth <= std::max(1, budget.maxDepth); ++depth) {
+        float value = 0.0f;
+        int action = searchRoot(root, actions, depth, value);
+        if (aborted) {
+            break;
+        }
+        bestAction = action;
+        stats.depthReached = depth;
+
+        // Search the previous best action first next time; it tightens the window early
+        auto best = std::find(actions.begin(), actions.end(), bestAction);
+        std::rotate(actions.begin(), best, best + 1);
+
+        // A forced result won't change with more depth
+        if (value >= VALUE_MAX || value <= VALUE_MIN) {
+            break;
+        }
+    }
+
+    stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    model = nullptr;
+    return BattleModel::toDecision(bestAction);
+}
+
+// Search the root at a fixed depth
+int ExpectiminimaxPolicy::searchRoot(const BattleState& root, const std::vector<int>& actions, int depth, float& bestValue) {
+    int bestAction = actions[0];
+    bestValue = VALUE_MIN - 1.0f;
+    for (int action : actions) {
+        float alpha = std::max(VALUE_MIN, bestValue);
+        float value = searchAction(root, action, depth, alpha, VALUE_MAX);
+        if (aborted) {
+            return bestAction;
+        }
+        if (value > bestValue) {
+            bestValue = value;
+            bestAction = action;
+        }
+    }
+    return bestAction;
+}
+
+// Value of a state before the side to move's status check
+float ExpectiminimaxPolicy::searchStep(const BattleState& state, int depth, float alpha, float beta) {
+    if (model->isTerminal(state) || depth <= 0 || outOfTime()) {
+        return model->evaluate(state, self);
+    }
+    std::vector<ModelOutcome> outcomes;
+    model->statusCheckOutcomes(state, outcomes);
+    return searchChance(outcomes, depth, alpha, beta, true);
+}
+
+// Value of a state where the side to move picks an action
+float ExpectiminimaxPolicy::searchDecision(const BattleState& state, int depth, float alpha, float beta) {
+    BattleSide mover = model->sideToMove(state);
+    std::vector<int> actions;
+    model->legalActions(state, mover, actions);
+    if (actions.empty()) {
+        return model->evaluate(state, self);
+    }
+
+    // Reuse a result from another move order, or at least try its best action first
+    uint64_t key = state.hash ^ DECISION_NODE_KEY;
+    TableEntry entry;
+    if (table->probe(key, entry)) {
+        toTable(self, entry.value, entry.bound);
+        if (entry.depth >= depth) {
+            if (entry.bound == BoundType::EXACT ||
+                (entry.bound == BoundType::LOWER && entry.value >= beta) ||
+                (entry.bound == BoundType::UPPER && entry.value <= alpha)) {
+                return entry.value;
+            }
+        }
+        auto hashAction = std::find(actions.begin(), actions.end(), entry.bestAction);
+        if (hashAction != actions.end()) {
+            std::rotate(actions.begin(), hashAction, hashAction + 1);
+        }
+    }
+
+    float alphaIn = alpha;
+    float betaIn = beta;
+    bool maximizing = mover == self;
+    float best = maximizing ? VALUE_MIN : VALUE_MAX;
+    int bestAction = actions[0];
+    for (int action : actions) {
+        float value = searchAction(state, action, depth, alpha, beta);
+        if (maximizing ? value > best : value < best) {
+            best = value;
+            bestAction = action;
+        }
+        if (maximizing) {
+            alpha = std::max(alpha, value);
+        } else {
+            beta = std::min(beta, value);
+        }
+        if (alpha >= beta || aborted) {
+            break;
+        }
+    }
+
+    if (!aborted) {
+        entry.value = best;
+        entry.bestAction = bestAction;
+        entry.depth = depth;
+        entry.bound = best <= alphaIn ? BoundType::UPPER : (best >= betaIn ? BoundType::LOWER : BoundType::EXACT);
+        toTable(self, entry.value, entry.bound);
+        table->store(key, entry);
+    }
+    return best;
+}
+
+// Value of the side to move performing an action
+float ExpectiminimaxPolicy::searchAction(const BattleState& state, int action, int depth, float alpha, float beta) {
+    std::vector<ModelOutcome> outcomes;
+    model->actionOutcomes(state, action, outcomes);
+    return searchChance(outcomes, depth - 1, alpha, beta, false);
+}
+
+// Star1-pruned expectation over chance outcomes
+float ExpectiminimaxPolicy::searchChance(const std::vector<ModelOutcome>& outcomes, int depth, float alpha, float beta,
+                                         bool statusCheck) {
+    double remaining = 1.0;
+    double sum = 0.0;
+    for (const ModelOutcome& outcome : outcomes) {
+        double p = outcome.probability;
+        remaining -= p;
+
+        // Window for this child such that the node's value could still fall inside (alpha, beta)
+        float childAlpha = static_cast<float>((alpha - sum - remaining * VALUE_MAX) / p);
+        float childBeta = static_cast<float>((beta - sum - remaining * VALUE_MIN) / p);
+        childAlpha = std::max(VALUE_MIN, childAlpha);
+        childBeta = std::min(VALUE_MAX, childBeta);
+
+        // A lost step costs a ply like an action does, so chains of skipped steps end
+        float value;
+        if (!statusCheck) {
+            value = searchStep(outcome.state, depth, childAlpha, childBeta);
+        } else if (outcome.canMove) {
+            value = searchDecision(outcome.state, depth, childAlpha, childBeta);
+        } else {
+            value = searchStep(outcome.state, depth - 1, childAlpha, childBeta);
+        }
+        sum += p * value;
+        if (aborted) {
+            return static_cast<float>(sum);
+        }
+
+        // Cut off once the remaining outcomes can no longer bring the value back into the window
+        double upper = sum + remaining * VALUE_MAX;
+        double lower = sum + remaining * VALUE_MIN;
+        if (upper <= alpha) {
+            return static_cast<float>(upper);
+        }
+        if (lower >= beta) {
+            return static_cast<float>(lower);
+        }
+    }
+    return static_cast<float>(sum);
+}
+
+// Count a node and check the clock
+bool ExpectiminimaxPolicy::outOfTime() {
+    stats.nodes++;
+    if (stats.depthReached == 0) {
+        // The first iteration always completes so there is an answer
+        return false;
+    }
+    if (!aborted && stats.nodes % CLOCK_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline) {
+        aborted = true;
+    }
+    return aborted;
+}
\ No newline at end of file
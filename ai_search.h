@@ -0,0 +1,115 @@
+#ifndef AI_SEARCH_H
+#define AI_SEARCH_H
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "battle_policy.h"
+#include "battle_model.h"
+#include "transposition_table.h"
+
+/**
+ * @brief How much work a search-based policy may do per decision
+ */
+struct SearchBudget {
+    int maxDepth = 4;           // Maximum number of decisions looked ahead
+    int timeLimitMs = 30;       // Wall-clock limit per decision
+};
+
+/**
+ * @brief Statistics of the most recent search
+ */
+struct SearchStats {
+    int depthReached = 0;       // Deepest fully completed iteration
+    long long nodes = 0;        // Nodes visited across all iterations
+    double elapsedMs = 0.0;
+};
+
+/**
+ * @brief Policy that picks actions with expectiminimax search over the battle model
+ *
+ * Chance nodes (status checks, hit/miss, critical hits, status procs and
+ * recovery) are pruned with Star1 bounds, decision nodes with alpha-beta.
+ * Iterative deepening keeps the best action of the last completed depth, so
+ * the policy always answers within its time limit. Decision nodes are cached
+ * in a transposition table, which several policies may share.
+ */
+class ExpectiminimaxPolicy : public DecisionPolicy {
+public:
+    /**
+     * @brief Constructor for ExpectiminimaxPolicy
+     * @param budget Depth and time limits per decision
+     * @param table Transposition table to use (a private one is created if null)
+     */
+    explicit ExpectiminimaxPolicy(const SearchBudget& budget = SearchBudget(),
+                                  std::shared_ptr<TranspositionTable> table = nullptr);
+
+    BattleDecision decide(const Battle& battle, BattleSide side) override;
+
+    /**
+     * @brief Change the search limits
+     * @param budget New depth and time limits
+     */
+    void setBudget(const SearchBudget& budget);
+
+    /**
+     * @brief Get statistics of the most recent decision
+     * @return The search statistics
+     */
+    const SearchStats& getLastStats() const;
+
+    /**
+     * @brief Get the transposition table (for sharing and hit rate statistics)
+     * @return The table
+     */
+    std::shared_ptr<TranspositionTable> getTable() const;
+
+private:
+    SearchBudget budget;
+    SearchStats stats;
+    std::shared_ptr<TranspositionTable> table;
+
+    // Per-search state
+    const BattleModel* model;
+    BattleSide self;
+    std::chrono::steady_clock::time_point deadline;
+    bool aborted;
+
+    /**
+     * @brief Search the root and return the best action at a fixed depth
+     * @param root The root state (status check already passed)
+     * @param actions Root actions, best guess first
+     * @param depth Search depth
+     * @param bestValue Receives the value of the best action
+     * @return The best action
+     */
+    int searchRoot(const BattleState& root, const std::vector<int>& actions, int depth, float& bestValue);
+
+    /**
+     * @brief Value of a state before the side to move's status check
+     */
+    float searchStep(const BattleState& state, int depth, float alpha, float beta);
+
+    /**
+     * @brief Value of a state where the side to move picks an action
+     */
+    float searchDecision(const BattleState& state, int depth, float alpha, float beta);
+
+    /**
+     * @brief Value of the side to move performing an action
+     */
+    float searchAction(const BattleState& state, int action, int depth, float alpha, float beta);
+
+    /**
+     * @brief Star1-pruned expectation over chance outcomes
+     */
+    float searchChance(const std::vector<ModelOutcome>& outcomes, int depth, float alpha, float beta, bool statusCheck);
+
+    /**
+     * @brief Count a node and check the clock
+     * @return True if the search ran out of time
+     */
+    bool outOfTime();
+};
+
+#endif // AI_SEARCH_H
\ No newline at end of file
@@ -1,77 +1,205 @@
 #include "battle.h"
+#include "metrics.h"
 #include <iostream>
 #include <algorithm>
-#include <chrono>
-#include <thread>
+#include <functional>
 
-Battle::Battle(Team& p, Team& e, float difficulty, const Environment& env)
-    : playerTeam(p), enemyTeam(e), difficultyMultiplier(difficulty), environment(env) {
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    rng.seed(seed);
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Build the sink that shows a battle on a stream; console frames go straight to the terminal
+TerminalEventSink* makeTerminal(std::ostream& stream) {
+#ifndef _WIN32
+    if (&stream == &std::cout) {
+        return new TerminalEventSink(STDOUT_FILENO);
+    }
+#endif
+    return new TerminalEventSink(stream);
 }
 
-bool Battle::start() {
-    std::cout << "\n========== BATTLE START ==========" << std::endl;
-    std::cout << "Environment: " << environment.getName() << std::endl;
+} // namespace
 
-    if (playerTeam.members.empty() || enemyTeam.members.empty()) {
-        std::cout << "Error: One or both teams have no Pokemon!" << std::endl;
-        return false;
+Battle::Battle(Team& p, Team& e, float difficulty, const Environment& env)
+    : playerTeam(p), enemyTeam(e), seed(Rng::randomSeed()), rng(seed), difficultyMultiplier(difficulty),
+      environment(env), turnCount(0), turnLimit(0) {
+    // Interactive battles: the player uses the console, the enemy picks random moves
+    // (seeded from another stream so the battle's own dice depend on its seed only)
+    ownedPlayerPolicy.reset(new ConsolePolicy());
+    ownedEnemyPolicy.reset(new RandomMovePolicy(Rng::forStream(seed, 1)()));
+    playerPolicy = ownedPlayerPolicy.get();
+    enemyPolicy = ownedEnemyPolicy.get();
+    terminal.reset(makeTerminal(std::cout));
+    events.subscribe(*terminal);
+}
+
+Battle::Battle(Team& p, Team& e, float difficulty, const Environment& env,
+               DecisionPolicy& playerPolicy, DecisionPolicy& enemyPolicy, uint64_t battleSeed,
+               std::ostream* output)
+    : playerTeam(p), enemyTeam(e), seed(battleSeed), rng(battleSeed), difficultyMultiplier(difficulty),
+      environment(env), playerPolicy(&playerPolicy), enemyPolicy(&enemyPolicy),
+      turnCount(0), turnLimit(DEFAULT_TURN_LIMIT) {
+    if (output) {
+        terminal.reset(makeTerminal(*output));
+        events.subscribe(*terminal);
     }
+}
 
-    auto playerIt = std::find_if(playerTeam.members.begin(), playerTeam.members.end(), 
-                                  [](const Pokemon& p) { return !p.isDefeated(); });
-    auto enemyIt = std::find_if(enemyTeam.members.begin(), enemyTeam.members.end(), 
-                                 [](const Pokemon& p) { return !p.isDefeated(); });
+bool Battle::start() {
+    emit(BattleEventType::BATTLE_START, static_cast<uint8_t>(environment.getType()));
 
-    if (playerIt == playerTeam.members.end() || enemyIt == enemyTeam.members.end()) {
-        std::cout << "Error: One or both teams have no active Pokemon!" << std::endl;
+    std::optional<int> playerFirst = playerTeam.getFirstAliveIndex();
+    std::optional<int> enemyFirst = enemyTeam.getFirstAliveIndex();
+    if (!playerFirst || !enemyFirst) {
+        emit(BattleEventType::NO_ACTIVE_POKEMON);
+        events.flush();
         return false;
     }
 
-    Pokemon& playerPokemon = *playerIt;
-    Pokemon& enemyPokemon = *enemyIt;
+    emit(BattleEventType::SEND_OUT, playerTeam.getMember(*playerFirst));
+    emit(BattleEventType::SEND_OUT, enemyTeam.getMember(*enemyFirst));
 
-    std::cout << "Go, " << playerPokemon.name << "!" << std::endl;
-    std::cout << "Enemy sent out " << enemyPokemon.name << "!" << std::endl;
+    bool playerRan = false;
+    bool enemyRan = false;
+    turnCount = 0;
 
-    bool battleContinue = true;
-    bool playerWon = false;
+    while (true) {
+        std::optional<int> playerIndex = playerTeam.getFirstAliveIndex();
+        std::optional<int> enemyIndex = enemyTeam.getFirstAliveIndex();
+        if (!playerIndex || !enemyIndex) {
+            break;
+        }
+        if (turnLimit > 0 && turnCount >= turnLimit) {
+            emit(BattleEventType::TURN_LIMIT);
+            break;
+        }
+        turnCount++;
+        ScopedTimer turnTimer(Metric::BATTLE_TURN);
 
-    while (battleContinue) {
+        const Pokemon& playerPokemon = playerTeam.getMember(*playerIndex);
+        const Pokemon& enemyPokemon = enemyTeam.getMember(*enemyIndex);
         displayBattleStatus(playerPokemon, enemyPokemon);
-        bool playerFirst = playerPokemon.speed >= enemyPokemon.speed;
-
-        if (playerFirst) {
-            battleContinue = playerTurn();
-            if (!battleContinue) {
-                playerWon = std::any_of(playerTeam.members.begin(), playerTeam.members.end(), 
-                                         [](const Pokemon& p) { return !p.isDefeated(); });
-                break;
-            }
-            battleContinue = enemyTurn();
-        } else {
-            battleContinue = enemyTurn();
-            if (!battleContinue) {
-                playerWon = std::any_of(playerTeam.members.begin(), playerTeam.members.end(), 
-                                         [](const Pokemon& p) { return !p.isDefeated(); });
-                break;
-            }
-            battleContinue = playerTurn();
+
+        // Faster Pokemon moves first
+        BattleSide first = playerPokemon.speed >= enemyPokemon.speed ? BattleSide::PLAYER : BattleSide::ENEMY;
+        BattleSide second = first == BattleSide::PLAYER ? BattleSide::ENEMY : BattleSide::PLAYER;
+
+        if (!takeTurn(first)) {
+            (first == BattleSide::PLAYER ? playerRan : enemyRan) = true;
+            break;
+        }
+        if (playerTeam.isDefeated() || enemyTeam.isDefeated()) {
+            break;
+        }
+        if (!takeTurn(second)) {
+            (second == BattleSide::PLAYER ? playerRan : enemyRan) = true;
+            break;
         }
     }
 
+    bool playerWon = !playerRan && !playerTeam.isDefeated() && (enemyRan || enemyTeam.isDefeated());
+
+    emit(BattleEventType::BATTLE_RESULT, playerWon ? 1 : 0);
     if (playerWon) {
-        std::cout << "You won the battle!" << std::endl;
         int totalExp = 0;
-        for (const auto& pokemon : enemyTeam.members) {
+        for (const auto& pokemon : enemyTeam.getMembers()) {
             totalExp += generateExperience(pokemon);
         }
         applyExperience(totalExp);
-    } else {
-        std::cout << "You lost the battle!" << std::endl;
     }
 
-    std::cout << "========== BATTLE END ==========" << std::endl;
+    if (events.isObserved()) {
+        int hpLeft = 0;
+        int maxHp = 0;
+        for (const auto& pokemon : playerTeam.getMembers()) {
+            hpLeft += pokemon.hp;
+            maxHp += pokemon.maxHp;
+        }
+        BattleEvent end = {};
+        end.type = BattleEventType::BATTLE_END;
+        end.species = INVALID_SPECIES_ID;
+        end.move = INVALID_MOVE_ID;
+        end.value = turnCount;
+        end.total = maxHp > 0 ? hpLeft * 100 / maxHp : 0;
+        events.emit(end);
+    }
+    events.flush();
     return playerWon;
+}
+
+const Team& Battle::getTeam(BattleSide side) const {
+    return side == BattleSide::PLAYER ? playerTeam : enemyTeam;
+}
+
+const Pokemon& Battle::getActivePokemon(BattleSide side) const {
+    // A battle only runs with at least one member a side, so there is always a first member
+    const Team& team = getTeam(side);
+    return team.getMember(team.getFirstAliveIndex().value_or(0));
+}
+
+const Environment& Battle::getEnvironment() const {
+    return environment;
+}
+
+float Battle::getDifficulty() const {
+    return difficultyMultiplier;
+}
+
+int Battle::getTurnCount() const {
+    return turnCount;
+}
+
+void Battle::setTurnLimit(int limit) {
+    turnLimit = limit;
+}
+
+void Battle::addEventSink(BattleEventSink& sink) {
+    events.subscribe(sink);
+}
+
+BattleSide Battle::sideOf(const Pokemon& pokemon) const {
+    const std::vector<Pokemon>& members = playerTeam.getMembers();
+    std::less<const Pokemon*> before;
+    bool isPlayer = !members.empty() && !before(&pokemon, members.data()) &&
+                    before(&pokemon, members.data() + members.size());
+    return isPlayer ? BattleSide::PLAYER : BattleSide::ENEMY;
+}
+
+BattleEvent Battle::eventFor(BattleEventType type, const Pokemon& pokemon) const {
+    BattleEvent event = {};
+    event.type = type;
+    event.side = static_cast<uint8_t>(sideOf(pokemon));
+    event.status = static_cast<uint8_t>(pokemon.status);
+    event.species = pokemon.species;
+    event.move = INVALID_MOVE_ID;
+    return event;
+}
+
+void Battle::emit(BattleEventType type, uint8_t detail) {
+    BattleEvent event = {};
+    event.type = type;
+    event.detail = detail;
+    event.species = INVALID_SPECIES_ID;
+    event.move = INVALID_MOVE_ID;
+    events.emit(event);
+}
+
+void Battle::emit(BattleEventType type, const Pokemon& pokemon, int value) {
+    if (!events.isObserved()) {
+        return;
+    }
+    BattleEvent event = eventFor(type, pokemon);
+    event.value = value;
+    events.emit(event);
+}
+
+void Battle::setSeed(uint64_t newSeed) {
+    seed = newSeed;
+    rng.seed(newSeed);
+}
+
+uint64_t Battle::getSeed() const {
+    return seed;
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 #ifndef BATTLE_H
 #define BATTLE_H
 
-#include <random>
+#include <memory>
+#include <ostream>
 #include "team.h"
 #include "environment.h"
 #include "status.h"
+#include "battle_policy.h"
+#include "rng.h"
+#include "damage_calc.h"
+#include "battle_events.h"
 
 /**
  * @brief Class for handling Pokemon battles
@@ -20,77 +25,176 @@ public:
      */
     Battle(Team& p, Team& e, float difficulty, const Environment& env);
     
+    /**
+     * @brief Constructor for a headless Battle driven by decision policies
+     * @param p Player's team
+     * @param e Enemy team
+     * @param difficulty Difficulty multiplier
+     * @param env Battle environment
+     * @param playerPolicy Policy making the player's decisions
+     * @param enemyPolicy Policy making the enemy's decisions
+     * @param seed Seed for the battle's random number generator
+     * @param output Stream the battle text is rendered to (nullptr for no text)
+     */
+    Battle(Team& p, Team& e, float difficulty, const Environment& env,
+           DecisionPolicy& playerPolicy, DecisionPolicy& enemyPolicy, uint64_t seed,
+           std::ostream* output = nullptr);
+    
     /**
      * @brief Start the battle
      * @return True if the player won
      */
     bool start();
+    
+    /**
+     * @brief Get the team on one side of the battle
+     * @param side The side to get
+     * @return The team on that side
+     */
+    const Team& getTeam(BattleSide side) const;
+    
+    /**
+     * @brief Get the active (first non-defeated) Pokemon on one side
+     * @param side The side to get
+     * @return The active Pokemon (the first member once the side is defeated)
+     */
+    const Pokemon& getActivePokemon(BattleSide side) const;
+    
+    /**
+     * @brief Get the battle environment
+     * @return The environment
+     */
+    const Environment& getEnvironment() const;
+    
+    /**
+     * @brief Get the difficulty multiplier
+     * @return The difficulty multiplier
+     */
+    float getDifficulty() const;
+    
+    /**
+     * @brief Get the number of turns played so far
+     * @return The turn count
+     */
+    int getTurnCount() const;
+    
+    /**
+     * @brief Set the maximum number of turns before the battle is called off as a loss
+     * @param limit The turn limit (0 for no limit)
+     */
+    void setTurnLimit(int limit);
+    
+    /**
+     * @brief Get the exact damage distribution of a move, without rolling any dice
+     * @param attacker The attacking Pokemon
+     * @param defender The defending Pokemon
+     * @param move ID of the move used
+     * @return Damage histogram, hit/crit/status chances and KO statistics
+     */
+    DamageDistribution getDamageDistribution(const Pokemon& attacker, const Pokemon& defender, MoveId move) const;
+    
+    /**
+     * @brief Get the hit chance and expected damage of every move of a Pokemon against a whole team
+     * @param attacker The attacking Pokemon
+     * @param defenders The opposing team (one column per member)
+     * @return One row per move and one column per team member
+     */
+    DamageMatrix getDamageMatrix(const Pokemon& attacker, const Team& defenders) const;
+    
+    /**
+     * @brief Subscribe a sink to the battle's events
+     * @param sink The sink (must outlive the battle)
+     */
+    void addEventSink(BattleEventSink& sink);
+    
+    /**
+     * @brief Reseed the battle's random number generator
+     * @param seed The new seed (the whole battle replays exactly from it)
+     */
+    void setSeed(uint64_t seed);
+    
+    /**
+     * @brief Get the seed the battle's dice were started from
+     * @return The seed (replaying the same decisions from it replays the battle)
+     */
+    uint64_t getSeed() const;
+    
+    static constexpr int DEFAULT_TURN_LIMIT = 1000;
 
 private:
     Team& playerTeam;
     Team& enemyTeam;
-    std::mt19937 rng;
+    uint64_t seed;
+    Rng rng;
     float difficultyMultiplier;
     Environment environment;
+    std::unique_ptr<DecisionPolicy> ownedPlayerPolicy;
+    std::unique_ptr<DecisionPolicy> ownedEnemyPolicy;
+    DecisionPolicy* playerPolicy;
+    DecisionPolicy* enemyPolicy;
+    BattleEventLog events;
+    std::unique_ptr<TerminalEventSink> terminal;    // Renders the events to the output stream, if any
+    int turnCount;
+    int turnLimit;
     
     /**
-     * @brief Handle the player's turn
+     * @brief Handle one side's turn
+     * @param side The side taking its turn
      * @return True if the battle should continue
      */
-    bool playerTurn();
+    bool takeTurn(BattleSide side);
     
     /**
-     * @brief Handle the enemy's turn
-     * @return True if the battle should continue
+     * @brief Get the side a Pokemon fights on
+     * @param pokemon A member of either team
+     * @return The Pokemon's side
      */
-    bool enemyTurn();
+    BattleSide sideOf(const Pokemon& pokemon) const;
     
     /**
-     * @brief Use a move
-     * @param attacker The attacking Pokemon
-     * @param defender The defending Pokemon
-     * @param move The move to use
-     * @return Damage dealt
+     * @brief Build an event about a Pokemon (side, species and status filled in)
+     * @param type The event type
+     * @param pokemon The Pokemon the event is about
+     * @return The event
      */
-    int useMove(Pokemon& attacker, Pokemon& defender, const Move& move);
+    BattleEvent eventFor(BattleEventType type, const Pokemon& pokemon) const;
     
     /**
-     * @brief Calculate damage for a move
-     * @param attacker The attacking Pokemon
-     * @param defender The defending Pokemon
-     * @param move The move used
-     * @return The calculated damage
+     * @brief Emit an event that isn't about any Pokemon
+     * @param type The event type
+     * @param detail Type-specific detail
      */
-    int calculateDamage(const Pokemon& attacker, const Pokemon& defender, const Move& move);
+    void emit(BattleEventType type, uint8_t detail = 0);
     
     /**
-     * @brief Display the battle menu
-     * @param activePokemon The active Pokemon
-     * @return The selected option
+     * @brief Emit an event about a Pokemon
+     * @param type The event type
+     * @param pokemon The Pokemon the event is about
+     * @param value Type-specific value
      */
-    int displayBattleMenu(const Pokemon& activePokemon);
+    void emit(BattleEventType type, const Pokemon& pokemon, int value = 0);
     
     /**
-     * @brief Display the move selection menu
-     * @param activePokemon The active Pokemon
-     * @return The index of the selected move
-     */
-    int displayMoveMenu(const Pokemon& activePokemon);
-    
-    /**
-     * @brief Display the item menu
-     * @return The index of the selected item
+     * @brief Use a move
+     * @param attacker The attacking Pokemon
+     * @param defender The defending Pokemon
+     * @param move ID of the move to use
+     * @return Damage dealt
      */
-    int displayItemMenu();
+    int useMove(Pokemon& attacker, Pokemon& defender, MoveId move);
     
     /**
-     * @brief Display the Pokemon switch menu
-     * @return The index of the Pokemon to switch to
+     * @brief Calculate damage for a move
+     * @param attacker The attacking Pokemon
+     * @param defender The defending Pokemon
+     * @param move ID of the move used
+     * @param critical Whether the hit is a critical hit
+     * @return The calculated damage
      */
-    int displaySwitchMenu();
+    int calculateDamage(const Pokemon& attacker, const Pokemon& defender, MoveId move, bool critical);
     
     /**
-     * @brief Display battle status
+     * @brief Report both active Pokemon at the start of a turn
      * @param playerPokemon The player's active Pokemon
      * @param enemyPokemon The enemy's active Pokemon
      */
@@ -103,6 +207,20 @@ private:
      */
     bool checkStatusEffects(Pokemon& pokemon);
     
+    /**
+     * @brief Apply a status effect from a move (fails if the Pokemon already has one)
+     * @param pokemon The target
+     * @param status The status effect
+     */
+    void inflictStatus(Pokemon& pokemon, StatusEffect status);
+    
+    /**
+     * @brief Set a Pokemon's HP through its team, so the team knows who can still battle
+     * @param pokemon A member of either team
+     * @param hp The new HP (clamped at 0)
+     */
+    void setHp(Pokemon& pokemon, int hp);
+    
     /**
      * @brief Check for status recovery
      * @param pokemon The Pokemon to check for recovery
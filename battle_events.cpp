@@ -0,0 +1,375 @@
+#include "battle_events.h"
+#include "pokemon.h"
+#include "environment.h"
+#include "item.h"
+#include "metrics.h"
+#include <algorithm>
+#include <iostream>
+#include <cstdio>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Get the name of a species
+const std::string& speciesName(SpeciesId species) {
+    return SpeciesRegistry::instance().get(species).name;
+}
+
+// Append "Your " or "Enemy "
+void appendOwner(std::string& text, const BattleEvent& event) {
+    text += event.getSide() == BattleSide::PLAYER ? "Your " : "Enemy ";
+}
+
+// Append a Pokemon's name followed by some text and a line break
+void appendLine(std::string& text, SpeciesId species, const char* rest) {
+    text += speciesName(species);
+    text += rest;
+    text += '\n';
+}
+
+} // namespace
+
+// Get the name of an event type
+const char* eventTypeToString(BattleEventType type) {
+    switch (type) {
+        case BattleEventType::BATTLE_START: return "BATTLE_START";
+        case BattleEventType::NO_ACTIVE_POKEMON: return "NO_ACTIVE_POKEMON";
+        case BattleEventType::SEND_OUT: return "SEND_OUT";
+        case BattleEventType::TURN_LIMIT: return "TURN_LIMIT";
+        case BattleEventType::POKEMON_STATUS: return "POKEMON_STATUS";
+        case BattleEventType::CANT_MOVE: return "CANT_MOVE";
+        case BattleEventType::NO_PP: return "NO_PP";
+        case BattleEventType::MOVE_USED: return "MOVE_USED";
+        case BattleEventType::MISSED: return "MISSED";
+        case BattleEventType::NO_EFFECT: return "NO_EFFECT";
+        case BattleEventType::CRITICAL_HIT: return "CRITICAL_HIT";
+        case BattleEventType::EFFECTIVENESS: return "EFFECTIVENESS";
+        case BattleEventType::DAMAGE: return "DAMAGE";
+        case BattleEventType::STATUS_APPLIED: return "STATUS_APPLIED";
+        case BattleEventType::STATUS_BLOCKED: return "STATUS_BLOCKED";
+        case BattleEventType::STATUS_DAMAGE: return "STATUS_DAMAGE";
+        case BattleEventType::STATUS_CURED: return "STATUS_CURED";
+        case BattleEventType::FAINTED: return "FAINTED";
+        case BattleEventType::ITEM_HEALED: return "ITEM_HEALED";
+        case BattleEventType::ITEM_CURED: return "ITEM_CURED";
+        case BattleEventType::ITEM_STAT_ROSE: return "ITEM_STAT_ROSE";
+        case BattleEventType::ITEM_REVIVED: return "ITEM_REVIVED";
+        case BattleEventType::ITEM_NO_EFFECT: return "ITEM_NO_EFFECT";
+        case BattleEventType::SWITCH_FAILED: return "SWITCH_FAILED";
+        case BattleEventType::SWITCH: return "SWITCH";
+        case BattleEventType::RAN_AWAY: return "RAN_AWAY";
+        case BattleEventType::BATTLE_RESULT: return "BATTLE_RESULT";
+        case BattleEventType::EXPERIENCE: return "EXPERIENCE";
+        case BattleEventType::LEVEL_UP: return "LEVEL_UP";
+        case BattleEventType::EVOLVING: return "EVOLVING";
+        case BattleEventType::EVOLVED: return "EVOLVED";
+        case BattleEventType::BATTLE_END: return "BATTLE_END";
+    }
+    return "UNKNOWN";
+}
+
+// Constructor
+BattleEventLog::BattleEventLog() : head(0), tail(0) {
+}
+
+// Subscribe a sink
+void BattleEventLog::subscribe(BattleEventSink& sink) {
+    sinks.push_back(&sink);
+}
+
+// Unsubscribe a sink, delivering what it is owed first
+void BattleEventLog::unsubscribe(BattleEventSink& sink) {
+    flush();
+    sinks.erase(std::remove(sinks.begin(), sinks.end(), &sink), sinks.end());
+}
+
+// Hand every buffered event to the sinks (in at most two contiguous runs)
+void BattleEventLog::flush() {
+    if (head == tail) {
+        return;
+    }
+    ScopedTimer timer(Metric::EVENT_FLUSH);
+    while (head != tail) {
+        size_t start = static_cast<size_t>(head & (CAPACITY - 1));
+        size_t count = std::min(static_cast<size_t>(tail - head), CAPACITY - start);
+        for (BattleEventSink* sink : sinks) {
+            sink->consume(&ring[start], count);
+        }
+        head += count;
+    }
+    for (BattleEventSink* sink : sinks) {
+        sink->endBatch();
+    }
+}
+
+// Constructor
+TerminalEventSink::TerminalEventSink(std::ostream& stream) : out(&stream), fd(-1) {
+}
+
+// Constructor
+TerminalEventSink::TerminalEventSink(int descriptor) : out(nullptr), fd(descriptor) {
+}
+
+// Render a batch of events onto the frame
+void TerminalEventSink::consume(const BattleEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        render(events[i]);
+    }
+}
+
+// Write out everything the flush rendered at once
+void TerminalEventSink::endBatch() {
+    writeFrame();
+    frame.clear();
+}
+
+// Get the colored display of a side's Pokemon, rebuilding it only when the Pokemon or its status changed
+const std::string& TerminalEventSink::display(const BattleEvent& event) {
+    CachedDisplay& cached = displays[event.side & 1];
+    if (cached.species != event.species || cached.status != event.status || cached.text.empty()) {
+        cached.species = event.species;
+        cached.status = event.status;
+        cached.text = coloredDisplay(event.species, event.getStatus());
+    }
+    return cached.text;
+}
+
+// Write the composed frame
+void TerminalEventSink::writeFrame() {
+    if (frame.empty()) {
+        return;
+    }
+#ifndef _WIN32
+    if (fd >= 0) {
+        std::cout.flush();
+        const char* data = frame.data();
+        size_t left = frame.size();
+        while (left > 0) {
+            ssize_t written = ::write(fd, data, left);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;     // The terminal went away; nothing left to show the text on
+            }
+            data += written;
+            left -= static_cast<size_t>(written);
+        }
+        return;
+    }
+#endif
+    std::ostream& stream = out ? *out : std::cout;
+    stream.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+}
+
+// Render one event as battle text
+void TerminalEventSink::render(const BattleEvent& event) {
+    switch (event.type) {
+        case BattleEventType::BATTLE_START:
+            frame += "\n========== BATTLE START ==========\nEnvironment: ";
+            frame += Environment(static_cast<BattleEnvironment>(event.detail)).getName();
+            frame += '\n';
+            break;
+        case BattleEventType::NO_ACTIVE_POKEMON:
+            frame += "Error: One or both teams have no active Pokemon!\n";
+            break;
+        case BattleEventType::SEND_OUT:
+            frame += event.getSide() == BattleSide::PLAYER ? "Go, " : "Enemy sent out ";
+            appendLine(frame, event.species, "!");
+            break;
+        case BattleEventType::TURN_LIMIT:
+            frame += "The battle dragged on for too long and was called off!\n";
+            break;
+        case BattleEventType::POKEMON_STATUS: {
+            const int barWidth = 20;
+            int filledWidth = static_cast<int>((float)event.value / event.total * barWidth);
+            filledWidth = std::max(0, std::min(barWidth, filledWidth));
+            char hp[32];
+            std::snprintf(hp, sizeof(hp), "HP: %3d/%d [", static_cast<int>(event.value), static_cast<int>(event.total));
+            frame += '\n';
+            appendOwner(frame, event);
+            frame += display(event);
+            frame += '\n';
+            frame += hp;
+            frame.append(filledWidth, '=');
+            frame.append(barWidth - filledWidth, ' ');
+            frame += "]\n";
+            break;
+        }
+        case BattleEventType::CANT_MOVE:
+            appendOwner(frame, event);
+            appendLine(frame, event.species, " couldn't move!");
+            break;
+        case BattleEventType::NO_PP:
+            frame += "There's no PP left for this move!\n";
+            break;
+        case BattleEventType::MOVE_USED:
+            frame += speciesName(event.species);
+            frame += " used ";
+            frame += moveRegistry().getName(event.move);
+            frame += "!\n";
+            break;
+        case BattleEventType::MISSED:
+            frame += "But it missed!\n";
+            break;
+        case BattleEventType::NO_EFFECT:
+            frame += "It has no effect...\n";
+            break;
+        case BattleEventType::CRITICAL_HIT:
+            frame += "A critical hit!\n";
+            break;
+        case BattleEventType::EFFECTIVENESS:
+            frame += event.value > 100 ? "It's super effective!\n" : "It's not very effective...\n";
+            break;
+        case BattleEventType::DAMAGE:
+            appendOwner(frame, event);
+            frame += speciesName(event.species);
+            frame += " dealt ";
+            frame += std::to_string(event.value);
+            frame += " damage!\n";
+            break;
+        case BattleEventType::STATUS_APPLIED:
+            if (event.detail) {
+                frame += speciesName(event.species);
+                frame += " is now ";
+                frame += statusToString(event.getStatus());
+                frame += "!\n";
+            } else {
+                appendLine(frame, event.species, " already has a status condition!");
+            }
+            break;
+        case BattleEventType::STATUS_BLOCKED:
+            switch (event.getStatus()) {
+                case StatusEffect::PARALYSIS:
+                    appendLine(frame, event.species, " is fully paralyzed and can't move!");
+                    break;
+                case StatusEffect::SLEEP:
+                    appendLine(frame, event.species, " is fast asleep!");
+                    break;
+                default:
+                    appendLine(frame, event.species, " is frozen solid!");
+                    break;
+            }
+            break;
+        case BattleEventType::STATUS_DAMAGE:
+            switch (event.getStatus()) {
+                case StatusEffect::BURN:
+                    appendLine(frame, event.species, " was hurt by its burn!");
+                    break;
+                case StatusEffect::POISON:
+                    appendLine(frame, event.species, " was hurt by poison!");
+                    break;
+                default:
+                    appendLine(frame, event.species, " hurt itself in confusion!");
+                    break;
+            }
+            break;
+        case BattleEventType::STATUS_CURED:
+            switch (event.getStatus()) {
+                case StatusEffect::SLEEP:
+                    appendLine(frame, event.species, " woke up!");
+                    break;
+                case StatusEffect::FROZEN:
+                    appendLine(frame, event.species, " thawed out!");
+                    break;
+                default:
+                    appendLine(frame, event.species, " snapped out of confusion!");
+                    break;
+            }
+            break;
+        case BattleEventType::FAINTED:
+            appendOwner(frame, event);
+            appendLine(frame, event.species, " fainted!");
+            break;
+        case BattleEventType::ITEM_HEALED:
+            frame += speciesName(event.species);
+            frame += " recovered ";
+            frame += std::to_string(event.value);
+            frame += " HP!\n";
+            break;
+        case BattleEventType::ITEM_CURED:
+            frame += speciesName(event.species);
+            frame += " was cured of ";
+            frame += statusToString(event.getStatus());
+            frame += "!\n";
+            break;
+        case BattleEventType::ITEM_STAT_ROSE:
+            frame += speciesName(event.species);
+            frame += "'s ";
+            frame += statToString(static_cast<Stat>(event.detail));
+            frame += " rose!\n";
+            break;
+        case BattleEventType::ITEM_REVIVED:
+            appendLine(frame, event.species, " was revived!");
+            break;
+        case BattleEventType::ITEM_NO_EFFECT:
+            frame += static_cast<ItemType>(event.detail) == ItemType::STATUS_HEAL ? "It had no effect!\n"
+                                                                               : "The item had no effect!\n";
+            break;
+        case BattleEventType::SWITCH_FAILED:
+            frame += "That Pokemon is unable to battle!\n";
+            break;
+        case BattleEventType::SWITCH:
+            frame += "Go, ";
+            appendLine(frame, event.species, "!");
+            break;
+        case BattleEventType::RAN_AWAY:
+            frame += "Got away safely!\n";
+            break;
+        case BattleEventType::BATTLE_RESULT:
+            frame += event.detail ? "You won the battle!\n" : "You lost the battle!\n";
+            break;
+        case BattleEventType::EXPERIENCE:
+            frame += "Earned ";
+            frame += std::to_string(event.value);
+            frame += " experience points!\n";
+            break;
+        case BattleEventType::LEVEL_UP:
+            frame += speciesName(event.species);
+            frame += " grew to level ";
+            frame += std::to_string(event.value);
+            frame += "!\n";
+            break;
+        case BattleEventType::EVOLVING:
+            appendLine(frame, event.species, " is evolving!");
+            break;
+        case BattleEventType::EVOLVED:
+            frame += "Congratulations! Your ";
+            appendLine(frame, event.species, " evolved!");
+            break;
+        case BattleEventType::BATTLE_END:
+            frame += "========== BATTLE END ==========\n";
+            break;
+    }
+}
+
+// Constructor
+LogEventSink::LogEventSink(std::ostream& stream) : out(stream) {
+}
+
+// Write one line per event: type, side, species, move, status, detail, value, total
+void LogEventSink::consume(const BattleEvent* events, size_t count) {
+    text.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const BattleEvent& event = events[i];
+        text += eventTypeToString(event.type);
+        text += event.getSide() == BattleSide::PLAYER ? "\tplayer\t" : "\tenemy\t";
+        text += event.species != INVALID_SPECIES_ID ? speciesName(event.species) : "-";
+        text += '\t';
+        text += event.move != INVALID_MOVE_ID ? moveRegistry().getName(event.move) : "-";
+        text += '\t';
+        text += statusToString(event.getStatus());
+        text += '\t';
+        text += std::to_string(event.detail);
+        text += '\t';
+        text += std::to_string(event.value);
+        text += '\t';
+        text += std::to_string(event.total);
+        text += '\n';
+    }
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
\ No newline at end of file
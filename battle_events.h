@@ -0,0 +1,240 @@
+#ifndef BATTLE_EVENTS_H
+#define BATTLE_EVENTS_H
+
+#include <array>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "species.h"
+#include "move_registry.h"
+#include "battle_policy.h"
+
+/**
+ * @brief Everything that can happen in a battle, as reported to event sinks
+ */
+enum class BattleEventType : uint8_t {
+    BATTLE_START,       // detail: BattleEnvironment
+    NO_ACTIVE_POKEMON,  // A team had nobody able to battle
+    SEND_OUT,           // A side's first Pokemon enters
+    TURN_LIMIT,         // The battle was called off
+    POKEMON_STATUS,     // Start of turn summary; value: HP, total: max HP
+    CANT_MOVE,
+    NO_PP,
+    MOVE_USED,          // move: the move
+    MISSED,
+    NO_EFFECT,          // The target is immune to the move's type
+    CRITICAL_HIT,       // About the attacker
+    EFFECTIVENESS,      // value: type effectiveness in percent (never 0 or 100)
+    DAMAGE,             // value: damage dealt by the Pokemon
+    STATUS_APPLIED,     // status: the new status; detail: 0 if the Pokemon already had one
+    STATUS_BLOCKED,     // status: the status that stopped the Pokemon
+    STATUS_DAMAGE,      // status: the status that hurt the Pokemon; value: damage
+    STATUS_CURED,       // status: the status that wore off
+    FAINTED,
+    ITEM_HEALED,        // value: HP restored
+    ITEM_CURED,         // status: the status cured
+    ITEM_STAT_ROSE,     // detail: Stat
+    ITEM_REVIVED,
+    ITEM_NO_EFFECT,     // detail: ItemType of the item
+    SWITCH_FAILED,
+    SWITCH,
+    RAN_AWAY,
+    BATTLE_RESULT,      // detail: 1 if the player won
+    EXPERIENCE,         // value: experience earned
+    LEVEL_UP,           // value: new level
+    EVOLVING,
+    EVOLVED,            // species: the evolved form
+    BATTLE_END          // value: turns fought; total: percent of the player's total HP left
+};
+
+/**
+ * @brief One typed battle event
+ *
+ * Events carry IDs and numbers only; sinks turn them into text, records or
+ * nothing at all. Fields a type doesn't use are zero, or INVALID_SPECIES_ID
+ * and INVALID_MOVE_ID for the IDs.
+ */
+struct BattleEvent {
+    BattleEventType type;
+    uint8_t side;           // BattleSide of the Pokemon the event is about
+    uint8_t status;         // StatusEffect
+    uint8_t detail;         // Meaning depends on the type
+    SpeciesId species;
+    MoveId move;
+    int32_t value;
+    int32_t total;
+
+    /**
+     * @brief Get the side the event is about
+     * @return The side
+     */
+    BattleSide getSide() const { return static_cast<BattleSide>(side); }
+
+    /**
+     * @brief Get the event's status effect
+     * @return The status effect
+     */
+    StatusEffect getStatus() const { return static_cast<StatusEffect>(status); }
+};
+
+static_assert(std::is_trivially_copyable<BattleEvent>::value && sizeof(BattleEvent) == 16,
+              "battle events are copied around in bulk");
+
+/**
+ * @brief Get the name of an event type
+ * @param type The event type
+ * @return Upper case name, as written to logs
+ */
+const char* eventTypeToString(BattleEventType type);
+
+/**
+ * @brief Receives the events of a battle in batches
+ */
+class BattleEventSink {
+public:
+    virtual ~BattleEventSink() = default;
+
+    /**
+     * @brief Handle a batch of events, in the order they happened
+     * @param events The events
+     * @param count Number of events
+     */
+    virtual void consume(const BattleEvent* events, size_t count) = 0;
+
+    /**
+     * @brief Called once a flush has handed over all its events (a wrapped ring arrives in two batches)
+     */
+    virtual void endBatch() {}
+};
+
+/**
+ * @brief Per-battle ring buffer of events, drained in batches to its sinks
+ *
+ * Events are dropped at once when nobody subscribed, so silent battles pay
+ * for neither formatting nor buffering. Otherwise they are handed to the
+ * sinks when the ring fills up and whenever the battle flushes it (before a
+ * side decides, so a human sees everything up to their turn).
+ */
+class BattleEventLog {
+public:
+    static constexpr size_t CAPACITY = 256;     // A power of two
+
+    BattleEventLog();
+
+    /**
+     * @brief Subscribe a sink (it must outlive the log or be unsubscribed first)
+     * @param sink The sink
+     */
+    void subscribe(BattleEventSink& sink);
+
+    /**
+     * @brief Unsubscribe a sink
+     * @param sink The sink
+     */
+    void unsubscribe(BattleEventSink& sink);
+
+    /**
+     * @brief Check if any sink is subscribed
+     * @return True if events are kept
+     */
+    bool isObserved() const { return !sinks.empty(); }
+
+    /**
+     * @brief Add an event
+     * @param event The event
+     */
+    void emit(const BattleEvent& event) {
+        if (sinks.empty()) {
+            return;
+        }
+        if (tail - head == CAPACITY) {
+            flush();
+        }
+        ring[tail++ & (CAPACITY - 1)] = event;
+    }
+
+    /**
+     * @brief Hand every buffered event to the sinks
+     */
+    void flush();
+
+private:
+    std::array<BattleEvent, CAPACITY> ring;
+    uint64_t head;
+    uint64_t tail;
+    std::vector<BattleEventSink*> sinks;
+};
+
+/**
+ * @brief Sink that renders events as the battle text shown to a player
+ *
+ * The events of each flush (everything up to a side's decision) are composed
+ * into one reusable frame buffer and written out at once. The colored name, type
+ * and status text of each side's Pokemon is cached until the Pokemon or its
+ * status changes.
+ */
+class TerminalEventSink : public BattleEventSink {
+public:
+    /**
+     * @brief Constructor for a sink writing to a stream
+     * @param stream Stream the text is written to (one write per frame)
+     */
+    explicit TerminalEventSink(std::ostream& stream);
+
+    /**
+     * @brief Constructor for a sink writing straight to a file descriptor
+     * @param descriptor Descriptor each frame is written to with a single write(2); std::cout is
+     *                   flushed first so text printed through it stays in order
+     */
+    explicit TerminalEventSink(int descriptor);
+
+    void consume(const BattleEvent* events, size_t count) override;
+    void endBatch() override;
+
+private:
+    struct CachedDisplay {
+        SpeciesId species = INVALID_SPECIES_ID;
+        uint8_t status = 0;
+        std::string text;
+    };
+
+    std::ostream* out;          // Stream frames go to, or nullptr
+    int fd;                     // Descriptor frames go to, or -1
+    std::string frame;          // Reused between frames
+    CachedDisplay displays[2];  // Indexed by BattleSide
+
+    void render(const BattleEvent& event);
+    const std::string& display(const BattleEvent& event);
+    void writeFrame();
+};
+
+/**
+ * @brief Sink that writes one tab separated line per event, for tools and later analysis
+ */
+class LogEventSink : public BattleEventSink {
+public:
+    /**
+     * @brief Constructor for LogEventSink
+     * @param stream Stream the log is written to
+     */
+    explicit LogEventSink(std::ostream& stream);
+
+    void consume(const BattleEvent* events, size_t count) override;
+
+private:
+    std::ostream& out;
+    std::string text;
+};
+
+/**
+ * @brief Sink that ignores every event (measures the cost of keeping events without rendering them)
+ */
+class NullEventSink : public BattleEventSink {
+public:
+    void consume(const BattleEvent*, size_t) override {}
+};
+
+#endif // BATTLE_EVENTS_H
\ No newline at end of file
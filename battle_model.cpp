@@ -0,0 +1,494 @@
+#include "battle_model.h"
+#include "battle.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+
+namespace {
+
+// Chances used by Battle::checkStatusEffects and Battle::checkStatusRecovery
+constexpr double PARALYSIS_SKIP_CHANCE = 0.25;
+constexpr double SLEEP_WAKE_CHANCE = 0.34;
+constexpr double FROZEN_THAW_CHANCE = 0.2;
+constexpr double CONFUSION_HIT_CHANCE = 0.33;
+constexpr double CONFUSION_RECOVERY_CHANCE = 0.33;
+
+// Add an outcome unless it can't happen
+void addOutcome(std::vector<ModelOutcome>& outcomes, double probability, bool canMove, const BattleState& state) {
+    if (probability <= 0.0) {
+        return;
+    }
+    ModelOutcome outcome;
+    outcome.probability = probability;
+    outcome.canMove = canMove;
+    outcome.state = state;
+    outcomes.push_back(outcome);
+}
+
+// Index of the side-to-move key
+int toMoveIndex(const BattleState& state) {
+    return state.phase == 0 ? 0 : 1 + state.firstMover;
+}
+
+} // namespace
+
+// Constructor: precompute the damage rolls and hit chances of every pairing
+BattleModel::BattleModel(const Battle& battle) {
+    const Environment& environment = battle.getEnvironment();
+    float difficulty = battle.getDifficulty();
+    environmentType = environment.getType();
+
+    // What the state doesn't hold goes into the base key: the difficulty and each team member's
+    // species, level and stats (members of one species and level can differ in stats)
+    uint32_t difficultyBits;
+    std::memcpy(&difficultyBits, &difficulty, sizeof(difficultyBits));
+    baseKey = zobristMix(difficultyBits);
+    for (int side = 0; side < 2; ++side) {
+        const Team& team = battle.getTeam(static_cast<BattleSide>(side));
+        memberCount[side] = std::min(team.size(), BATTLE_MAX_TEAM_SIZE);
+        for (int i = 0; i < memberCount[side]; ++i) {
+            const Pokemon& pokemon = team.getMember(i);
+            members[side][i] = &pokemon;
+            baseKey ^= zobristMix(zobristActive(side, i) ^ pokemon.species ^
+                                  (static_cast<uint64_t>(pokemon.level) << 48));
+            uint64_t stats = 0;
+            for (int stat : {pokemon.attack, pokemon.defense, pokemon.specialAttack, pokemon.specialDefense,
+                             pokemon.speed}) {
+                stats = zobristMix(stats ^ static_cast<uint64_t>(stat));
+            }
+            baseKey ^= zobristMix(zobristActive(side, i) + stats);
+        }
+    }
+
+    damageTable.resize(2 * BATTLE_MAX_TEAM_SIZE * BATTLE_MAX_MOVES * BATTLE_MAX_TEAM_SIZE * 2);
+    hitTable.resize(2 * BATTLE_MAX_TEAM_SIZE * BATTLE_MAX_MOVES * BATTLE_MAX_TEAM_SIZE);
+
+    for (int side = 0; side < 2; ++side) {
+        int other = 1 - side;
+        for (int a = 0; a < memberCount[side]; ++a) {
+            const Pokemon& attacker = *members[side][a];
+
+            // Confusion hurts with a typeless 40 power physical hit; the model uses the mean roll
+            int confusionSum = 0;
+            for (int roll = DAMAGE_ROLL_MIN; roll <= DAMAGE_ROLL_MAX; ++roll) {
+                confusionSum += computeDamage(attacker, attacker, CONFUSION_MOVE_ID, environment, difficulty, roll, false);
+            }
+            confusionDamage[side][a] = (confusionSum + DAMAGE_ROLL_COUNT / 2) / DAMAGE_ROLL_COUNT;
+
+            int moveCount = std::min(attacker.getMoveCount(), BATTLE_MAX_MOVES);
+            for (int m = 0; m < moveCount; ++m) {
+                MoveId move = attacker.getMove(m);
+                for (int d = 0; d < memberCount[other]; ++d) {
+                    const Pokemon& defender = *members[other][d];
+                    int index = tableIndex(side, a, m, d);
+                    hitTable[index] = computeHitChance(attacker, defender, move);
+
+                    for (int crit = 0; crit < 2; ++crit) {
+                        DamageRolls& rolls = damageTable[index * 2 + crit];
+                        for (int roll = 0; roll < DAMAGE_ROLL_COUNT; ++roll) {
+                            rolls.damage[roll] = computeDamage(attacker, defender, move, environment, difficulty,
+                                                               DAMAGE_ROLL_MIN + roll, crit == 1);
+                        }
+                        std::sort(rolls.damage, rolls.damage + DAMAGE_ROLL_COUNT);
+                        rolls.prefix[0] = 0;
+                        for (int roll = 0; roll < DAMAGE_ROLL_COUNT; ++roll) {
+                            rolls.prefix[roll + 1] = rolls.prefix[roll] + rolls.damage[roll];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Capture the battle's current position
+BattleState BattleModel::initialState(BattleSide sideToMove) const {
+    BattleState state{};
+    state.environment = static_cast<uint8_t>(environmentType);
+    for (int side = 0; side < 2; ++side) {
+        SideState& sideState = state.sides[side];
+        sideState.count = static_cast<uint8_t>(memberCount[side]);
+        int active = -1;
+        for (int i = 0; i < memberCount[side]; ++i) {
+            const Pokemon& pokemon = *members[side][i];
+            SlotState& slot = sideState.slots[i];
+            slot.hp = static_cast<uint16_t>(std::max(0, pokemon.hp));
+            slot.maxHp = static_cast<uint16_t>(std::max(0, pokemon.maxHp));
+            slot.species = pokemon.species;
+            slot.member = static_cast<uint8_t>(i);
+            slot.status = static_cast<uint8_t>(pokemon.status);
+            slot.moveCount = static_cast<uint8_t>(std::min(pokemon.getMoveCount(), BATTLE_MAX_MOVES));
+            for (int m = 0; m < BATTLE_MAX_MOVES; ++m) {
+                slot.moves[m] = m < slot.moveCount ? pokemon.getMove(m) : INVALID_MOVE_ID;
+            }
+            for (int m = 0; m < slot.moveCount; ++m) {
+                slot.pp[m] = static_cast<uint8_t>(pokemon.getPp(m));
+            }
+            for (int stat = 0; stat < STAT_COUNT; ++stat) {
+                slot.stages[stat] = pokemon.statModifiers[stat];
+            }
+            if (active < 0 && pokemon.hp > 0) {
+                active = i;
+            }
+        }
+        sideState.active = static_cast<uint8_t>(std::max(0, active));
+    }
+
+    // Pick the phase so that the deciding side is the one to move
+    BattleSide faster = BattleSide::PLAYER;
+    if (activeMember(state, 0).speed < activeMember(state, 1).speed) {
+        faster = BattleSide::ENEMY;
+    }
+    if (faster == sideToMove) {
+        state.phase = 0;
+    } else {
+        state.phase = 1;
+        state.firstMover = static_cast<uint8_t>(faster);
+    }
+    state.hash = computeHash(state);
+    return state;
+}
+
+// Get the side that acts next
+BattleSide BattleModel::sideToMove(const BattleState& state) const {
+    if (state.phase == 1) {
+        return opposingSide(state.getFirstMover());
+    }
+    return activeMember(state, 0).speed >= activeMember(state, 1).speed ? BattleSide::PLAYER : BattleSide::ENEMY;
+}
+
+// Check if one of the teams has no Pokemon left
+bool BattleModel::isTerminal(const BattleState& state) const {
+    for (const SideState& sideState : state.sides) {
+        if (sideState.count == 0 || sideState.slots[sideState.active].isFainted()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// List the actions available to a side
+void BattleModel::legalActions(const BattleState& state, BattleSide side, std::vector<int>& actions) const {
+    actions.clear();
+    const SideState& sideState = state.side(side);
+    const SlotState& active = sideState.slots[sideState.active];
+
+    // Moves without PP are skipped, unless every move is out of PP
+    for (int m = 0; m < active.moveCount; ++m) {
+        if (active.pp[m] > 0) {
+            actions.push_back(m);
+        }
+    }
+    if (actions.empty()) {
+        for (int m = 0; m < active.moveCount; ++m) {
+            actions.push_back(m);
+        }
+    }
+    for (int i = 0; i < sideState.count; ++i) {
+        if (i != sideState.active && !sideState.slots[i].isFainted()) {
+            actions.push_back(MODEL_SWITCH_BASE + i);
+        }
+    }
+}
+
+// Enumerate the outcomes of the status check before the side to move decides
+void BattleModel::statusCheckOutcomes(const BattleState& state, std::vector<ModelOutcome>& outcomes) const {
+    outcomes.clear();
+    BattleSide mover = sideToMove(state);
+    int s = static_cast<int>(mover);
+    int active = state.sides[s].active;
+    const SlotState& pokemon = state.sides[s].slots[active];
+
+    // Losing the step moves play on to the next mover
+    BattleState skipped = state;
+    advance(skipped, mover);
+
+    switch (pokemon.getStatus()) {
+        case StatusEffect::PARALYSIS:
+            addOutcome(outcomes, PARALYSIS_SKIP_CHANCE, false, skipped);
+            addOutcome(outcomes, 1.0 - PARALYSIS_SKIP_CHANCE, true, state);
+            break;
+        case StatusEffect::SLEEP:
+        case StatusEffect::FROZEN: {
+            double recoverChance = pokemon.getStatus() == StatusEffect::SLEEP ? SLEEP_WAKE_CHANCE : FROZEN_THAW_CHANCE;
+            BattleState recovered = state;
+            setStatus(recovered, s, active, StatusEffect::NONE);
+            addOutcome(outcomes, recoverChance, true, recovered);
+            addOutcome(outcomes, 1.0 - recoverChance, false, skipped);
+            break;
+        }
+        case StatusEffect::BURN:
+        case StatusEffect::POISON: {
+            int maxHp = pokemon.maxHp;
+            int damage = std::max(1, pokemon.getStatus() == StatusEffect::BURN ? maxHp / 16 : maxHp / 8);
+            BattleState hurt = state;
+            bool fainted = dealDamage(hurt, s, active, damage);
+            if (fainted) {
+                advance(hurt, mover);
+            }
+            addOutcome(outcomes, 1.0, !fainted, hurt);
+            break;
+        }
+        case StatusEffect::CONFUSION: {
+            BattleState hurt = skipped;
+            dealDamage(hurt, s, active, confusionDamage[s][pokemon.member]);
+            addOutcome(outcomes, CONFUSION_HIT_CHANCE, false, hurt);
+            addOutcome(outcomes, 1.0 - CONFUSION_HIT_CHANCE, true, state);
+            break;
+        }
+        default:
+            addOutcome(outcomes, 1.0, true, state);
+            break;
+    }
+}
+
+// Enumerate the outcomes of the side to move performing an action
+void BattleModel::actionOutcomes(const BattleState& state, int action, std::vector<ModelOutcome>& outcomes) const {
+    outcomes.clear();
+    BattleSide mover = sideToMove(state);
+    int s = static_cast<int>(mover);
+    int o = 1 - s;
+
+    // Switching ends the step without a recovery check; like Battle, it swaps the two slots
+    if (action >= MODEL_SWITCH_BASE) {
+        BattleState switched = state;
+        swapSlots(switched, s, state.sides[s].active, action - MODEL_SWITCH_BASE);
+        advance(switched, mover);
+        addOutcome(outcomes, 1.0, true, switched);
+        return;
+    }
+
+    int attackerIndex = state.sides[s].active;
+    int defenderIndex = state.sides[o].active;
+    const SlotState& attacker = state.sides[s].slots[attackerIndex];
+    const Pokemon& defender = activeMember(state, o);
+    const MoveRegistry& moves = moveRegistry();
+    MoveId move = attacker.moves[action];
+    int index = tableIndex(s, attacker.member, action, state.sides[o].slots[defenderIndex].member);
+    double hitChance = hitTable[index];
+    int defenderHp = state.sides[o].slots[defenderIndex].hp;
+    bool canInflict = moves.hasStatusEffect(move) && state.sides[o].slots[defenderIndex].getStatus() == StatusEffect::NONE;
+    double statusChance = canInflict ? moves.getStatusChance(move) / 100.0 : 0.0;
+
+    // Using the move spends PP whether it hits or not
+    BattleState used = state;
+    usePp(used, s, attackerIndex, action);
+
+    // Collect the results of the action first; the recovery check is applied to each of them
+    std::vector<ModelOutcome> results;
+    addOutcome(results, 1.0 - hitChance, true, used);
+
+    auto addHit = [&](double probability, int damage) {
+        BattleState hit = used;
+        if (dealDamage(hit, o, defenderIndex, damage)) {
+            addOutcome(results, probability, true, hit);
+            return;
+        }
+        BattleState inflicted = hit;
+        setStatus(inflicted, o, defenderIndex, moves.getStatusEffect(move));
+        addOutcome(results, probability * statusChance, true, inflicted);
+        addOutcome(results, probability * (1.0 - statusChance), true, hit);
+    };
+
+    if (moves.getCategory(move) == MoveCategory::STATUS) {
+        addHit(hitChance, 0);
+    } else if (defender.getTypeEffectiveness(moves.getType(move)) == 0.0f) {
+        addOutcome(results, hitChance, true, used);
+    } else {
+        for (int crit = 0; crit < 2; ++crit) {
+            double critChance = crit == 1 ? CRITICAL_HIT_CHANCE : 1.0 - CRITICAL_HIT_CHANCE;
+            const DamageRolls& rolls = damageTable[index * 2 + crit];
+
+            // Rolls are sorted, so the KO rolls are a suffix
+            int survivors = static_cast<int>(std::lower_bound(rolls.damage, rolls.damage + DAMAGE_ROLL_COUNT, defenderHp) - rolls.damage);
+            double rollChance = hitChance * critChance / DAMAGE_ROLL_COUNT;
+            if (survivors > 0) {
+                int meanDamage = (rolls.prefix[survivors] + survivors / 2) / survivors;
+                addHit(rollChance * survivors, meanDamage);
+            }
+            if (survivors < DAMAGE_ROLL_COUNT) {
+                addHit(rollChance * (DAMAGE_ROLL_COUNT - survivors), defenderHp);
+            }
+        }
+    }
+
+    for (const ModelOutcome& result : results) {
+        applyRecovery(result.state, mover, result.probability, outcomes);
+    }
+}
+
+// Hash a state from scratch (the turn number is not hashed)
+uint64_t BattleModel::computeHash(const BattleState& state) const {
+    uint64_t hash = baseKey ^ zobristEnvironment(state.getEnvironment()) ^ zobristToMove(toMoveIndex(state));
+    for (int side = 0; side < 2; ++side) {
+        const SideState& sideState = state.sides[side];
+        hash ^= zobristActive(side, sideState.active);
+        for (int slot = 0; slot < sideState.count; ++slot) {
+            hash ^= slotKey(side, slot, sideState.slots[slot]);
+        }
+    }
+    return hash;
+}
+
+// Heuristic value of a state
+float BattleModel::evaluate(const BattleState& state, BattleSide perspective) const {
+    float score[2];
+    for (int side = 0; side < 2; ++side) {
+        const SideState& sideState = state.sides[side];
+        if (sideState.count == 0) {
+            score[side] = 0.0f;
+            continue;
+        }
+        float hpFraction = 0.0f;
+        int alive = 0;
+        for (int i = 0; i < sideState.count; ++i) {
+            const SlotState& slot = sideState.slots[i];
+            if (!slot.isFainted()) {
+                alive++;
+                hpFraction += static_cast<float>(slot.hp) / std::max<int>(1, slot.maxHp);
+            }
+        }
+        score[side] = 0.5f * (hpFraction + alive) / sideState.count;
+    }
+
+    int own = static_cast<int>(perspective);
+    if (score[1 - own] == 0.0f) {
+        return 1.0f;
+    }
+    if (score[own] == 0.0f) {
+        return -1.0f;
+    }
+    return score[own] - score[1 - own];
+}
+
+// Pick one outcome at random according to the outcome probabilities
+int BattleModel::sampleOutcome(const std::vector<ModelOutcome>& outcomes, Rng& rng) {
+    double roll = rng.uniformFloat();
+    int last = static_cast<int>(outcomes.size()) - 1;
+    for (int i = 0; i < last; ++i) {
+        roll -= outcomes[i].probability;
+        if (roll < 0.0) {
+            return i;
+        }
+    }
+    return last;
+}
+
+// Convert a model action into a battle decision
+BattleDecision BattleModel::toDecision(int action) {
+    BattleDecision decision;
+    if (action >= MODEL_SWITCH_BASE) {
+        decision.action = BattleAction::SWITCH;
+        decision.pokemonIndex = action - MODEL_SWITCH_BASE;
+    } else {
+        decision.action = BattleAction::FIGHT;
+        decision.moveIndex = action;
+    }
+    return decision;
+}
+
+// Flattened index into the precomputed tables
+int BattleModel::tableIndex(int side, int attacker, int move, int defender) const {
+    return ((side * BATTLE_MAX_TEAM_SIZE + attacker) * BATTLE_MAX_MOVES + move) * BATTLE_MAX_TEAM_SIZE + defender;
+}
+
+// The Pokemon in a side's active slot
+const Pokemon& BattleModel::activeMember(const BattleState& state, int side) const {
+    const SideState& sideState = state.sides[side];
+    return *members[side][sideState.slots[sideState.active].member];
+}
+
+// Hash of everything in one slot: who is in it, its moves and PP, HP, status and stat stages
+uint64_t BattleModel::slotKey(int side, int slot, const SlotState& slotState) {
+    uint64_t key = zobristMember(side, slot, slotState.member) ^ zobristSpecies(side, slot, slotState.species) ^
+                   zobristHp(side, slot, slotState.hp) ^ zobristStatus(side, slot, slotState.getStatus());
+    for (int m = 0; m < slotState.moveCount; ++m) {
+        key ^= zobristMove(side, slot, m, slotState.moves[m]) ^ zobristPp(side, slot, m, slotState.pp[m]);
+    }
+    for (int stat = 0; stat < STAT_COUNT; ++stat) {
+        key ^= zobristStage(side, slot, static_cast<Stat>(stat), slotState.stages[stat]);
+    }
+    return key;
+}
+
+// Hand play to the next mover
+void BattleModel::advance(BattleState& state, BattleSide mover) {
+    state.hash ^= zobristToMove(toMoveIndex(state));
+    if (state.phase == 0) {
+        state.firstMover = static_cast<uint8_t>(mover);
+        state.phase = 1;
+    } else {
+        state.phase = 0;
+        state.turn++;
+    }
+    state.hash ^= zobristToMove(toMoveIndex(state));
+}
+
+// Lower a slot's HP; a fainted active Pokemon is replaced by the first one still standing
+bool BattleModel::dealDamage(BattleState& state, int side, int slot, int damage) {
+    SlotState& pokemon = state.sides[side].slots[slot];
+    int hp = std::max(0, pokemon.hp - damage);
+    state.hash ^= zobristHp(side, slot, pokemon.hp) ^ zobristHp(side, slot, hp);
+    pokemon.hp = static_cast<uint16_t>(hp);
+    if (hp > 0) {
+        return false;
+    }
+
+    const SideState& sideState = state.sides[side];
+    for (int i = 0; i < sideState.count; ++i) {
+        if (!sideState.slots[i].isFainted()) {
+            setActive(state, side, i);
+            break;
+        }
+    }
+    return true;
+}
+
+// Change a slot's status
+void BattleModel::setStatus(BattleState& state, int side, int slot, StatusEffect status) {
+    SlotState& pokemon = state.sides[side].slots[slot];
+    state.hash ^= zobristStatus(side, slot, pokemon.getStatus()) ^ zobristStatus(side, slot, status);
+    pokemon.status = static_cast<uint8_t>(status);
+}
+
+// Change a side's active slot
+void BattleModel::setActive(BattleState& state, int side, int slot) {
+    uint8_t& active = state.sides[side].active;
+    state.hash ^= zobristActive(side, active) ^ zobristActive(side, slot);
+    active = static_cast<uint8_t>(slot);
+}
+
+// Swap two slots of a side's line-up
+void BattleModel::swapSlots(BattleState& state, int side, int first, int second) {
+    SlotState* slots = state.sides[side].slots;
+    state.hash ^= slotKey(side, first, slots[first]) ^ slotKey(side, second, slots[second]);
+    std::swap(slots[first], slots[second]);
+    state.hash ^= slotKey(side, first, slots[first]) ^ slotKey(side, second, slots[second]);
+}
+
+// Spend one PP of a move
+void BattleModel::usePp(BattleState& state, int side, int slot, int move) {
+    uint8_t& pp = state.sides[side].slots[slot].pp[move];
+    if (pp > 0) {
+        state.hash ^= zobristPp(side, slot, move, pp) ^ zobristPp(side, slot, move, pp - 1);
+        pp--;
+    }
+}
+
+// Apply the end-of-step recovery check and hand play to the next mover
+void BattleModel::applyRecovery(const BattleState& state, BattleSide mover, double probability,
+                                std::vector<ModelOutcome>& outcomes) const {
+    int s = static_cast<int>(mover);
+    int active = state.sides[s].active;
+    BattleState next = state;
+    advance(next, mover);
+
+    if (state.sides[s].slots[active].getStatus() != StatusEffect::CONFUSION) {
+        addOutcome(outcomes, probability, true, next);
+        return;
+    }
+    BattleState recovered = next;
+    setStatus(recovered, s, active, StatusEffect::NONE);
+    addOutcome(outcomes, probability * CONFUSION_RECOVERY_CHANCE, true, recovered);
+    addOutcome(outcomes, probability * (1.0 - CONFUSION_RECOVERY_CHANCE), true, next);
+}
\ No newline at end of file
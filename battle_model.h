@@ -0,0 +1,165 @@
+#ifndef BATTLE_MODEL_H
+#define BATTLE_MODEL_H
+
+#include <vector>
+#include "battle_policy.h"
+#include "damage_calc.h"
+#include "rng.h"
+#include "zobrist.h"
+#include "battle_state.h"
+
+/**
+ * @brief Model actions are small integers: 0..3 use that move, SWITCH_BASE + i switches to the Pokemon in slot i
+ */
+constexpr int MODEL_SWITCH_BASE = BATTLE_MAX_MOVES;
+
+static_assert(BATTLE_MAX_TEAM_SIZE <= ZOBRIST_SLOTS, "every team slot needs Zobrist keys");
+static_assert(BATTLE_MAX_MOVES <= ZOBRIST_MOVES, "every move of a slot needs Zobrist keys");
+
+/**
+ * @brief One result of a chance event together with its probability
+ */
+struct ModelOutcome {
+    double probability = 0.0;
+    bool canMove = true;        // Status check outcomes only: whether the side gets to act
+    BattleState state;
+};
+
+/**
+ * @brief Forward model of the battle rules used by the search-based policies
+ *
+ * Mirrors Battle::takeTurn: a step is a status check (chance), a decision,
+ * then the action's resolution (chance) followed by the end-of-turn recovery
+ * check. Stats and types are read from the teams the model was built from;
+ * everything that changes lives in a BattleState, slot for slot, and the
+ * line-up follows Battle's rules: a switch swaps the active slot with the
+ * chosen one and a KO sends in the first slot still standing.
+ *
+ * Battle itself still runs on Teams of Pokemon, not on BattleState. The model
+ * leaves out what the search doesn't decide on: items, running away and the
+ * experience handed out after the battle.
+ */
+class BattleModel {
+public:
+    /**
+     * @brief Build a model of the current position of a battle
+     * @param battle The battle to model (must outlive the model)
+     */
+    explicit BattleModel(const Battle& battle);
+
+    /**
+     * @brief Capture the battle's current position
+     * @param sideToMove The side that is about to decide
+     * @return The model state
+     */
+    BattleState initialState(BattleSide sideToMove) const;
+
+    /**
+     * @brief Get the side that acts next
+     * @param state The model state
+     * @return The side to move
+     */
+    BattleSide sideToMove(const BattleState& state) const;
+
+    /**
+     * @brief Check if one of the teams has no Pokemon left
+     * @param state The model state
+     * @return True if the battle is over
+     */
+    bool isTerminal(const BattleState& state) const;
+
+    /**
+     * @brief List the actions available to a side
+     * @param state The model state
+     * @param side The deciding side
+     * @param actions Receives the legal actions (cleared first)
+     */
+    void legalActions(const BattleState& state, BattleSide side, std::vector<int>& actions) const;
+
+    /**
+     * @brief Enumerate the outcomes of the status check before the side to move decides
+     * @param state The model state
+     * @param outcomes Receives the outcomes (cleared first); canMove is false when the step is lost
+     */
+    void statusCheckOutcomes(const BattleState& state, std::vector<ModelOutcome>& outcomes) const;
+
+    /**
+     * @brief Enumerate the outcomes of the side to move performing an action
+     *
+     * Covers hit/miss, critical hits, KOs (exactly, from the damage rolls),
+     * status procs and the end-of-turn status recovery check. Non-KO damage
+     * uses the mean of the surviving rolls.
+     * @param state The model state
+     * @param action The action to perform
+     * @param outcomes Receives the outcomes (cleared first)
+     */
+    void actionOutcomes(const BattleState& state, int action, std::vector<ModelOutcome>& outcomes) const;
+
+    /**
+     * @brief Hash a state from scratch (the incrementally updated BattleState::hash always equals this)
+     * @param state The model state
+     * @return The Zobrist hash
+     */
+    uint64_t computeHash(const BattleState& state) const;
+
+    /**
+     * @brief Heuristic value of a state, between -1 (lost) and 1 (won)
+     * @param state The model state
+     * @param perspective The side the value is computed for
+     * @return The value
+     */
+    float evaluate(const BattleState& state, BattleSide perspective) const;
+
+    /**
+     * @brief Pick one outcome at random according to the outcome probabilities
+     * @param outcomes Outcomes from statusCheckOutcomes or actionOutcomes (must not be empty)
+     * @param rng The random number generator to use
+     * @return Index of the chosen outcome
+     */
+    static int sampleOutcome(const std::vector<ModelOutcome>& outcomes, Rng& rng);
+
+    /**
+     * @brief Convert a model action into a battle decision
+     * @param action The model action
+     * @return The equivalent decision
+     */
+    static BattleDecision toDecision(int action);
+
+private:
+    // Sorted damage of every roll and their prefix sums
+    struct DamageRolls {
+        int damage[DAMAGE_ROLL_COUNT];
+        int prefix[DAMAGE_ROLL_COUNT + 1];
+    };
+
+    const Pokemon* members[2][BATTLE_MAX_TEAM_SIZE];
+    int memberCount[2];
+    std::vector<DamageRolls> damageTable;   // [side][attacker][move][defender][critical]
+    std::vector<float> hitTable;            // [side][attacker][move][defender]
+    int confusionDamage[2][BATTLE_MAX_TEAM_SIZE];
+    BattleEnvironment environmentType;
+    uint64_t baseKey;                       // Hash of what the state doesn't hold
+
+    int tableIndex(int side, int attacker, int move, int defender) const;
+    const Pokemon& activeMember(const BattleState& state, int side) const;
+    static uint64_t slotKey(int side, int slot, const SlotState& slotState);
+    static void advance(BattleState& state, BattleSide mover);
+    static bool dealDamage(BattleState& state, int side, int slot, int damage);
+    static void setStatus(BattleState& state, int side, int slot, StatusEffect status);
+    static void setActive(BattleState& state, int side, int slot);
+    static void swapSlots(BattleState& state, int side, int first, int second);
+    static void usePp(BattleState& state, int side, int slot, int move);
+    void applyRecovery(const BattleState& state, BattleSide mover, double probability,
+                       std::vector<ModelOutcome>& outcomes) const;
+};
+
+/**
+ * @brief Get the opposing side
+ * @param side A side
+ * @return The other side
+ */
+inline BattleSide opposingSide(BattleSide side) {
+    return side == BattleSide::PLAYER ? BattleSide::ENEMY : BattleSide::PLAYER;
+}
+
+#endif // BATTLE_MODEL_H
\ No newline at end of file
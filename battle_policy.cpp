@@ -0,0 +1,173 @@
+#include "battle_policy.h"
+#include "battle.h"
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+// Ask the player for a decision through the console menus
+BattleDecision ConsolePolicy::decide(const Battle& battle, BattleSide side) {
+    const Team& team = battle.getTeam(side);
+    const Pokemon& activePokemon = battle.getActivePokemon(side);
+    BattleDecision decision;
+
+    decision.action = static_cast<BattleAction>(displayBattleMenu(activePokemon));
+
+    switch (decision.action) {
+        case BattleAction::FIGHT:
+            decision.moveIndex = displayMoveMenu(activePokemon);
+            break;
+        case BattleAction::ITEM:
+            decision.itemIndex = displayItemMenu(team);
+            if (decision.itemIndex >= 0) {
+                decision.pokemonIndex = displaySwitchMenu(team);
+            }
+            break;
+        case BattleAction::SWITCH:
+            decision.pokemonIndex = displaySwitchMenu(team);
+            break;
+        case BattleAction::RUN:
+            break;
+    }
+
+    return decision;
+}
+
+// Display the battle menu
+int ConsolePolicy::displayBattleMenu(const Pokemon& activePokemon) {
+    std::cout << "\nWhat will " << activePokemon.getName() << " do?" << std::endl;
+    std::cout << "1. Fight" << std::endl;
+    std::cout << "2. Item" << std::endl;
+    std::cout << "3. Pokemon" << std::endl;
+    std::cout << "4. Run" << std::endl;
+
+    std::cout << "Enter choice (1-4): ";
+    int choice = readChoice(4);
+
+    // Run once the input has ended; the battle could never finish otherwise
+    return choice > 0 ? choice : static_cast<int>(BattleAction::RUN);
+}
+
+// Display the move selection menu
+int ConsolePolicy::displayMoveMenu(const Pokemon& activePokemon) {
+    int moveCount = activePokemon.getMoveCount();
+    if (moveCount == 0) {
+        std::cout << activePokemon.getName() << " doesn't know any moves!" << std::endl;
+        return -1;
+    }
+
+    std::cout << "\nChoose a move:" << std::endl;
+
+    const MoveRegistry& moves = moveRegistry();
+    for (int i = 0; i < moveCount; ++i) {
+        MoveId move = activePokemon.getMove(i);
+        PokemonType type = moves.getType(move);
+        std::cout << i + 1 << ". " << getTypeColor(type) << moves.getName(move) << "\033[0m"
+                  << " (Type: " << typeToString(type)
+                  << ", Power: " << moves.getPower(move)
+                  << ", Accuracy: " << moves.getAccuracy(move)
+                  << ", PP: " << activePokemon.getPp(i) << "/" << moves.getPp(move) << ")" << std::endl;
+    }
+
+    std::cout << "Enter choice (1-" << moveCount << "): ";
+    return readChoice(moveCount) - 1;  // Convert to 0-based index
+}
+
+// Display the item menu
+int ConsolePolicy::displayItemMenu(const Team& team) {
+    if (team.items.empty()) {
+        std::cout << "You have no items!" << std::endl;
+        return -1;
+    }
+
+    std::cout << "\nChoose an item:" << std::endl;
+
+    for (int i = 0; i < team.items.size(); ++i) {
+        const Item& item = team.items.getItem(i);
+        std::cout << i + 1 << ". " << item.name << " x" << team.items.getCount(i) << " - "
+                  << item.getDescription() << std::endl;
+    }
+
+    std::cout << "Enter choice (1-" << team.items.size() << "): ";
+    return readChoice(team.items.size()) - 1;  // Convert to 0-based index
+}
+
+// Display the Pokemon switch menu
+int ConsolePolicy::displaySwitchMenu(const Team& team) {
+    std::cout << "\nChoose a Pokemon:" << std::endl;
+
+    for (int i = 0; i < team.size(); ++i) {
+        const Pokemon& pokemon = team.getMember(i);
+        std::cout << i + 1 << ". " << pokemon.getColoredDisplay()
+                  << " - HP: " << pokemon.hp << "/" << pokemon.maxHp
+                  << (pokemon.isDefeated() ? " (Fainted)" : "") << std::endl;
+    }
+
+    std::cout << "Enter choice (1-" << team.size() << "): ";
+    return readChoice(team.size()) - 1;  // Convert to 0-based index
+}
+
+// Read a menu choice, asking again until it is in range
+int ConsolePolicy::readChoice(int optionCount) {
+    int choice;
+    while (!(std::cin >> choice) || choice < 1 || choice > optionCount) {
+        if (std::cin.eof() || std::cin.bad()) {
+            return 0;
+        }
+        if (std::cin.fail()) {
+            // Skip the rest of a line that wasn't a number
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        std::cout << "Invalid choice. Try again: ";
+    }
+    return choice;
+}
+
+// Constructor
+RandomMovePolicy::RandomMovePolicy(uint64_t seed) : rng(seed) {
+}
+
+// Pick a uniformly random move of the active Pokemon
+BattleDecision RandomMovePolicy::decide(const Battle& battle, BattleSide side) {
+    const Pokemon& activePokemon = battle.getActivePokemon(side);
+    BattleDecision decision;
+    decision.action = BattleAction::FIGHT;
+
+    // Only moves with PP left, unless none has any
+    int usable[Pokemon::MAX_MOVES];
+    int usableCount = 0;
+    for (int i = 0; i < activePokemon.getMoveCount(); ++i) {
+        if (activePokemon.getPp(i) > 0 || !activePokemon.hasPpLeft()) {
+            usable[usableCount++] = i;
+        }
+    }
+    if (usableCount > 0) {
+        decision.moveIndex = usable[rng.uniformInt(0, usableCount - 1)];
+    }
+
+    return decision;
+}
+
+// Constructor
+RecordingPolicy::RecordingPolicy(DecisionPolicy& inner, std::vector<BattleDecision>& log)
+    : policy(inner), decisions(log) {
+}
+
+// Ask the inner policy and record its answer
+BattleDecision RecordingPolicy::decide(const Battle& battle, BattleSide side) {
+    BattleDecision decision = policy.decide(battle, side);
+    decisions.push_back(decision);
+    return decision;
+}
+
+// Constructor
+ReplayPolicy::ReplayPolicy(const std::vector<BattleDecision>& recorded) : decisions(recorded), position(0) {
+}
+
+// Play the next recorded decision
+BattleDecision ReplayPolicy::decide(const Battle&, BattleSide) {
+    if (position >= decisions.size()) {
+        throw std::runtime_error("Replay diverged: the battle asked for more decisions than were recorded");
+    }
+    return decisions[position++];
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#ifndef BATTLE_POLICY_H
+#define BATTLE_POLICY_H
+
+#include <vector>
+#include <cstddef>
+#include "team.h"
+#include "rng.h"
+
+class Battle;
+
+/**
+ * @brief Enum identifying a side of the battle
+ */
+enum class BattleSide {
+    PLAYER,
+    ENEMY
+};
+
+/**
+ * @brief Enum representing the actions available on a turn (matches the battle menu numbering)
+ */
+enum class BattleAction {
+    FIGHT = 1,
+    ITEM,
+    SWITCH,
+    RUN
+};
+
+/**
+ * @brief A single turn decision made by a policy
+ */
+struct BattleDecision {
+    BattleAction action = BattleAction::FIGHT;
+    int moveIndex = -1;     // Index into the active Pokemon's moves (FIGHT)
+    int itemIndex = -1;     // Index into the team's items (ITEM)
+    int pokemonIndex = -1;  // Target team member (ITEM, SWITCH)
+};
+
+/**
+ * @brief Interface for anything that makes decisions for one side of a battle
+ */
+class DecisionPolicy {
+public:
+    virtual ~DecisionPolicy() = default;
+
+    /**
+     * @brief Choose the action for this turn
+     * @param battle The battle being played (read-only)
+     * @param side The side this policy is deciding for
+     * @return The chosen decision
+     */
+    virtual BattleDecision decide(const Battle& battle, BattleSide side) = 0;
+};
+
+/**
+ * @brief Policy that asks a human through the console menus
+ */
+class ConsolePolicy : public DecisionPolicy {
+public:
+    BattleDecision decide(const Battle& battle, BattleSide side) override;
+
+private:
+    /**
+     * @brief Display the battle menu
+     * @param activePokemon The active Pokemon
+     * @return The selected option (Run once the input has ended)
+     */
+    int displayBattleMenu(const Pokemon& activePokemon);
+
+    /**
+     * @brief Display the move selection menu
+     * @param activePokemon The active Pokemon
+     * @return The index of the selected move, or -1 if there is none to choose
+     */
+    int displayMoveMenu(const Pokemon& activePokemon);
+
+    /**
+     * @brief Display the item menu
+     * @param team The team whose items are listed
+     * @return The index of the selected item, or -1 if there is none to choose
+     */
+    int displayItemMenu(const Team& team);
+
+    /**
+     * @brief Display the Pokemon switch menu
+     * @param team The team whose members are listed
+     * @return The index of the Pokemon to switch to
+     */
+    int displaySwitchMenu(const Team& team);
+
+    /**
+     * @brief Read a menu choice, asking again until it is in range
+     * @param optionCount Number of options (numbered from 1)
+     * @return The chosen option, or 0 if the input has ended
+     */
+    int readChoice(int optionCount);
+};
+
+/**
+ * @brief Policy that always fights with a uniformly random move
+ */
+class RandomMovePolicy : public DecisionPolicy {
+public:
+    /**
+     * @brief Constructor for RandomMovePolicy
+     * @param seed Seed for the policy's random number generator
+     */
+    explicit RandomMovePolicy(uint64_t seed);
+
+    BattleDecision decide(const Battle& battle, BattleSide side) override;
+
+private:
+    Rng rng;
+};
+
+/**
+ * @brief Policy that passes another policy's decisions through and records them
+ *
+ * Give both sides of a battle a RecordingPolicy writing to the same list to
+ * get the battle's decisions in the order they were made.
+ */
+class RecordingPolicy : public DecisionPolicy {
+public:
+    /**
+     * @brief Constructor for RecordingPolicy
+     * @param inner The policy actually deciding
+     * @param log List the decisions are appended to
+     */
+    RecordingPolicy(DecisionPolicy& inner, std::vector<BattleDecision>& log);
+
+    BattleDecision decide(const Battle& battle, BattleSide side) override;
+
+private:
+    DecisionPolicy& policy;
+    std::vector<BattleDecision>& decisions;
+};
+
+/**
+ * @brief Policy that plays back recorded decisions (use the same one for both sides)
+ */
+class ReplayPolicy : public DecisionPolicy {
+public:
+    /**
+     * @brief Constructor for ReplayPolicy
+     * @param recorded The decisions of both sides, in the order they were made
+     */
+    explicit ReplayPolicy(const std::vector<BattleDecision>& recorded);
+
+    /**
+     * @brief Play the next decision
+     * @throws std::runtime_error if the battle asks for more decisions than were recorded
+     */
+    BattleDecision decide(const Battle& battle, BattleSide side) override;
+
+    /**
+     * @brief Get the number of decisions played back so far
+     * @return Decision count
+     */
+    size_t getPosition() const { return position; }
+
+private:
+    const std::vector<BattleDecision>& decisions;
+    size_t position;
+};
+
+#endif // BATTLE_POLICY_H
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef BATTLE_STATE_H
+#define BATTLE_STATE_H
+
+#include <cstdint>
+#include <type_traits>
+#include "status.h"
+#include "stats.h"
+#include "environment.h"
+#include "species.h"
+#include "move_registry.h"
+#include "battle_policy.h"
+
+/**
+ * @brief Fixed capacities of a battle state
+ */
+constexpr int BATTLE_MAX_TEAM_SIZE = 6;
+constexpr int BATTLE_MAX_MOVES = 4;
+
+/**
+ * @brief One position of a team's line-up and everything about it that changes during a battle
+ *
+ * Like Battle, which swaps team members when switching, a switch swaps two
+ * slots, so a slot names the Pokemon in it. Stats and types never change in
+ * battle; they are looked up by member in the immutable tables of whoever
+ * runs the state (see BattleModel).
+ */
+struct SlotState {
+    uint16_t hp;
+    uint16_t maxHp;
+    SpeciesId species;
+    MoveId moves[BATTLE_MAX_MOVES];
+    uint8_t member;                     // Index of the Pokemon in the team the state was built from
+    uint8_t status;                     // StatusEffect
+    uint8_t moveCount;
+    uint8_t pp[BATTLE_MAX_MOVES];       // Remaining PP of each move (capped at 255)
+    int8_t stages[STAT_COUNT];          // Stat stages, -6..+6
+
+    /**
+     * @brief Get the slot's status
+     * @return The status effect
+     */
+    StatusEffect getStatus() const { return static_cast<StatusEffect>(status); }
+
+    /**
+     * @brief Check if the Pokemon in this slot has fainted
+     * @return True if HP is zero
+     */
+    bool isFainted() const { return hp == 0; }
+};
+
+/**
+ * @brief One side of a battle state
+ */
+struct SideState {
+    SlotState slots[BATTLE_MAX_TEAM_SIZE];
+    uint8_t count;                      // Number of occupied slots
+    uint8_t active;                     // Index of the active slot (always the first one not fainted)
+};
+
+/**
+ * @brief Compact, trivially copyable snapshot of a battle
+ *
+ * Copying a state is a plain memcpy of a few cache lines, so searches and
+ * rollouts fork it freely instead of copying Teams of Pokemon.
+ */
+struct BattleState {
+    SideState sides[2];                 // Indexed by BattleSide
+    uint64_t hash;                      // Zobrist hash, updated incrementally (the turn number is not hashed)
+    uint16_t turn;
+    uint8_t phase;                      // 0 = the faster side acts next, 1 = the other side acts next
+    uint8_t firstMover;                 // BattleSide that acted first this turn (valid when phase == 1)
+    uint8_t environment;                // BattleEnvironment
+
+    /**
+     * @brief Get one side of the state
+     * @param which The side
+     * @return The side's state
+     */
+    SideState& side(BattleSide which) { return sides[static_cast<int>(which)]; }
+    const SideState& side(BattleSide which) const { return sides[static_cast<int>(which)]; }
+
+    /**
+     * @brief Get the side that acted first this turn
+     * @return The first mover (valid when phase == 1)
+     */
+    BattleSide getFirstMover() const { return static_cast<BattleSide>(firstMover); }
+
+    /**
+     * @brief Get the battle environment
+     * @return The environment
+     */
+    BattleEnvironment getEnvironment() const { return static_cast<BattleEnvironment>(environment); }
+};
+
+static_assert(std::is_trivially_copyable<BattleState>::value, "battle states must be copyable with memcpy");
+static_assert(sizeof(BattleState) <= 6 * 64, "a battle state should fit in six cache lines");
+
+#endif // BATTLE_STATE_H
\ No newline at end of file
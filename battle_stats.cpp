@@ -0,0 +1,360 @@
+#include "battle_stats.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <iostream>
+#include <charconv>
+
+namespace {
+
+constexpr const char* STATS_HEADER = "# pokemon-battle-stats";
+constexpr int STATS_VERSION = 1;
+
+struct CounterField {
+    const char* key;
+    const char* label;
+    uint64_t BattleStats::* member;
+};
+
+// Every counter, in the order of the old positional file
+const CounterField COUNTERS[] = {
+    {"wins", "Wins", &BattleStats::wins},
+    {"losses", "Losses", &BattleStats::losses},
+    {"totalDamageDealt", "Total Damage Dealt", &BattleStats::totalDamageDealt},
+    {"totalDamageTaken", "Total Damage Taken", &BattleStats::totalDamageTaken},
+    {"pokemonDefeated", "Pokemon Defeated", &BattleStats::pokemonDefeated},
+    {"pokemonLost", "Pokemon Lost", &BattleStats::pokemonLost},
+    {"itemsUsed", "Items Used", &BattleStats::itemsUsed},
+    {"criticalHits", "Critical Hits", &BattleStats::criticalHits},
+    {"statusEffectsCaused", "Status Effects Caused", &BattleStats::statusEffectsCaused},
+    {"totalExperienceGained", "Total Experience Gained", &BattleStats::totalExperienceGained},
+    {"evolutionsTriggered", "Evolutions Triggered", &BattleStats::evolutionsTriggered},
+};
+
+struct HistogramField {
+    const char* key;
+    const char* label;
+    Histogram BattleStats::* member;
+};
+
+const HistogramField HISTOGRAMS[] = {
+    {"damagePerHit", "Damage Per Hit", &BattleStats::damagePerHit},
+    {"turnsPerBattle", "Turns Per Battle", &BattleStats::turnsPerBattle},
+    {"hpLeft", "HP Left (%)", &BattleStats::hpLeft},
+};
+
+// Write a histogram as key.field=value lines, with only the non-empty buckets
+void writeHistogram(std::ostream& out, const char* key, const Histogram& histogram) {
+    out << key << ".bucketWidth=" << histogram.bucketWidth << "\n";
+    out << key << ".samples=" << histogram.samples << "\n";
+    out << key << ".sum=" << histogram.sum << "\n";
+    out << key << ".max=" << histogram.maximum << "\n";
+    out << key << ".buckets=";
+    bool first = true;
+    for (int i = 0; i < Histogram::BUCKETS; ++i) {
+        if (histogram.counts[i] == 0) {
+            continue;
+        }
+        if (!first) {
+            out << " ";
+        }
+        out << i << ":" << histogram.counts[i];
+        first = false;
+    }
+    out << "\n";
+}
+
+// Parse a whole string as a number; returns false if it isn't one or doesn't fit
+template <typename T>
+bool parseNumber(const std::string& text, T& value) {
+    const char* end = text.data() + text.size();
+    std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+// Read one histogram field; returns false if the value is malformed
+bool readHistogramField(Histogram& histogram, const std::string& field, const std::string& value) {
+    if (field == "bucketWidth") {
+        int32_t width = 0;
+        if (!parseNumber(value, width) || width <= 0) {
+            return false;
+        }
+        histogram.bucketWidth = width;
+    } else if (field == "samples") {
+        return parseNumber(value, histogram.samples);
+    } else if (field == "sum") {
+        return parseNumber(value, histogram.sum);
+    } else if (field == "max") {
+        return parseNumber(value, histogram.maximum);
+    } else if (field == "buckets") {
+        histogram.counts.fill(0);
+        std::istringstream in(value);
+        std::string pair;
+        while (in >> pair) {
+            size_t colon = pair.find(':');
+            if (colon == std::string::npos) {
+                return false;
+            }
+            int bucket = 0;
+            if (!parseNumber(pair.substr(0, colon), bucket) || bucket < 0 || bucket >= Histogram::BUCKETS ||
+                !parseNumber(pair.substr(colon + 1), histogram.counts[bucket])) {
+                return false;
+            }
+        }
+    }
+    // Unknown fields come from newer versions and are skipped
+    return true;
+}
+
+// Read the old file of 11 counters, one per line
+bool loadPositional(BattleStats& stats, std::istream& in) {
+    BattleStats loaded;
+    for (const CounterField& counter : COUNTERS) {
+        long long value = 0;
+        if (!(in >> value)) {
+            return false;
+        }
+        loaded.*counter.member = static_cast<uint64_t>(std::max(0LL, value));
+    }
+    stats = loaded;
+    return true;
+}
+
+} // namespace
+
+// Count a value
+void Histogram::add(int64_t value) {
+    if (value < 0) {
+        value = 0;
+    }
+    int64_t bucket = value / bucketWidth;
+    counts[static_cast<size_t>(std::min<int64_t>(bucket, BUCKETS - 1))]++;
+    samples++;
+    sum += static_cast<uint64_t>(value);
+    maximum = std::max(maximum, value);
+}
+
+// Add another histogram's counts
+void Histogram::merge(const Histogram& other) {
+    for (int i = 0; i < BUCKETS; ++i) {
+        counts[i] += other.counts[i];
+    }
+    samples += other.samples;
+    sum += other.sum;
+    maximum = std::max(maximum, other.maximum);
+}
+
+// Get the mean of the values
+double Histogram::mean() const {
+    return samples > 0 ? static_cast<double>(sum) / static_cast<double>(samples) : 0.0;
+}
+
+// Get an upper bound of a percentile
+int64_t Histogram::percentile(double fraction) const {
+    if (samples == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(samples));
+    rank = std::min(std::max<uint64_t>(rank, 1), samples);
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min<int64_t>(static_cast<int64_t>(i + 1) * bucketWidth - 1, maximum);
+        }
+    }
+    return maximum;
+}
+
+// Add another set of statistics to this one
+void BattleStats::merge(const BattleStats& other) {
+    for (const CounterField& counter : COUNTERS) {
+        this->*counter.member += other.*counter.member;
+    }
+    for (const HistogramField& histogram : HISTOGRAMS) {
+        (this->*histogram.member).merge(other.*histogram.member);
+    }
+}
+
+// Save the statistics as versioned key=value lines
+bool BattleStats::saveToFile(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << STATS_HEADER << "\n";
+    file << "version=" << STATS_VERSION << "\n";
+    for (const CounterField& counter : COUNTERS) {
+        file << counter.key << "=" << this->*counter.member << "\n";
+    }
+    for (const HistogramField& histogram : HISTOGRAMS) {
+        writeHistogram(file, histogram.key, this->*histogram.member);
+    }
+    return static_cast<bool>(file);
+}
+
+// Load statistics saved by saveToFile, or the older positional file
+bool BattleStats::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        return false;
+    }
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    if (line != STATS_HEADER) {
+        file.clear();
+        file.seekg(0);
+        return loadPositional(*this, file);
+    }
+
+    BattleStats loaded;
+    bool versionSeen = false;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            return false;
+        }
+        std::string key = line.substr(0, equals);
+        std::string value = line.substr(equals + 1);
+
+        if (key == "version") {
+            int version = 0;
+            if (!parseNumber(value, version) || version > STATS_VERSION) {
+                return false;
+            }
+            versionSeen = true;
+            continue;
+        }
+        bool known = false;
+        for (const CounterField& counter : COUNTERS) {
+            if (key == counter.key) {
+                if (!parseNumber(value, loaded.*counter.member)) {
+                    return false;
+                }
+                known = true;
+                break;
+            }
+        }
+        if (known) {
+            continue;
+        }
+        size_t dot = key.find('.');
+        if (dot == std::string::npos) {
+            continue;
+        }
+        for (const HistogramField& histogram : HISTOGRAMS) {
+            if (key.compare(0, dot, histogram.key) == 0 && std::char_traits<char>::length(histogram.key) == dot) {
+                if (!readHistogramField(loaded.*histogram.member, key.substr(dot + 1), value)) {
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+    if (!versionSeen) {
+        return false;
+    }
+    *this = loaded;
+    return true;
+}
+
+// Display the statistics
+void BattleStats::display(std::ostream& out) const {
+    for (const CounterField& counter : COUNTERS) {
+        out << counter.label << ": " << this->*counter.member << "\n";
+    }
+    for (const HistogramField& field : HISTOGRAMS) {
+        const Histogram& histogram = this->*field.member;
+        if (histogram.samples == 0) {
+            continue;
+        }
+        out << field.label << ": mean " << histogram.mean()
+            << ", median <= " << histogram.percentile(0.5)
+            << ", 90th percentile <= " << histogram.percentile(0.9)
+            << ", max " << histogram.maximum
+            << " (" << histogram.samples << " samples)\n";
+    }
+    out << std::flush;
+}
+
+// Constructor
+StatShards::StatShards(size_t count) : shards(std::max<size_t>(count, 1)) {
+}
+
+// Merge every shard
+BattleStats StatShards::merged() const {
+    BattleStats total;
+    for (const Shard& entry : shards) {
+        total.merge(entry.stats);
+    }
+    return total;
+}
+
+// Constructor
+StatsEventSink::StatsEventSink(BattleStats& target) : stats(target) {
+}
+
+// Count the events, from the player's side
+void StatsEventSink::consume(const BattleEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const BattleEvent& event = events[i];
+        bool player = event.getSide() == BattleSide::PLAYER;
+        switch (event.type) {
+            case BattleEventType::DAMAGE:
+                if (event.value > 0) {
+                    stats.damagePerHit.add(event.value);
+                    (player ? stats.totalDamageDealt : stats.totalDamageTaken) += static_cast<uint64_t>(event.value);
+                }
+                break;
+            case BattleEventType::CRITICAL_HIT:
+                if (player) {
+                    stats.criticalHits++;
+                }
+                break;
+            case BattleEventType::STATUS_APPLIED:
+                if (!player && event.detail) {
+                    stats.statusEffectsCaused++;
+                }
+                break;
+            case BattleEventType::FAINTED:
+                (player ? stats.pokemonLost : stats.pokemonDefeated)++;
+                break;
+            case BattleEventType::ITEM_HEALED:
+            case BattleEventType::ITEM_CURED:
+            case BattleEventType::ITEM_STAT_ROSE:
+            case BattleEventType::ITEM_REVIVED:
+            case BattleEventType::ITEM_NO_EFFECT:
+                if (player) {
+                    stats.itemsUsed++;
+                }
+                break;
+            case BattleEventType::BATTLE_RESULT:
+                (event.detail ? stats.wins : stats.losses)++;
+                break;
+            case BattleEventType::EXPERIENCE:
+                stats.totalExperienceGained += static_cast<uint64_t>(std::max(0, event.value));
+                break;
+            case BattleEventType::EVOLVED:
+                stats.evolutionsTriggered++;
+                break;
+            case BattleEventType::BATTLE_END:
+                stats.turnsPerBattle.add(event.value);
+                stats.hpLeft.add(event.total);
+                break;
+            default:
+                break;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#ifndef BATTLE_STATS_H
+#define BATTLE_STATS_H
+
+#include <array>
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include "battle_events.h"
+
+/**
+ * @brief Histogram of non-negative values in equal-width buckets (the last one is open-ended)
+ */
+struct Histogram {
+    static constexpr int BUCKETS = 64;
+
+    int32_t bucketWidth;
+    uint64_t samples = 0;
+    uint64_t sum = 0;
+    int64_t maximum = 0;
+    std::array<uint64_t, BUCKETS> counts = {};
+
+    /**
+     * @brief Constructor for Histogram
+     * @param width Width of each bucket
+     */
+    explicit Histogram(int width = 1) : bucketWidth(width) {}
+
+    /**
+     * @brief Count a value (negative values count as 0)
+     * @param value The value
+     */
+    void add(int64_t value);
+
+    /**
+     * @brief Add another histogram's counts (bucket widths must match)
+     * @param other The histogram to add
+     */
+    void merge(const Histogram& other);
+
+    /**
+     * @brief Get the mean of the values
+     * @return The mean (0 without samples)
+     */
+    double mean() const;
+
+    /**
+     * @brief Get an upper bound of a percentile
+     * @param fraction The percentile, from 0 to 1
+     * @return Top of the bucket the percentile falls in (capped at the maximum seen)
+     */
+    int64_t percentile(double fraction) const;
+};
+
+/**
+ * @brief Statistics of many battles, from the player's side
+ *
+ * Counters are 64-bit so bulk simulations can run for as long as they like.
+ */
+struct BattleStats {
+    uint64_t wins = 0;
+    uint64_t losses = 0;
+    uint64_t totalDamageDealt = 0;
+    uint64_t totalDamageTaken = 0;
+    uint64_t pokemonDefeated = 0;
+    uint64_t pokemonLost = 0;
+    uint64_t itemsUsed = 0;
+    uint64_t criticalHits = 0;
+    uint64_t statusEffectsCaused = 0;
+    uint64_t totalExperienceGained = 0;
+    uint64_t evolutionsTriggered = 0;
+
+    Histogram damagePerHit{5};          // Damage of every hit, by either side
+    Histogram turnsPerBattle{5};
+    Histogram hpLeft{2};                // Percent of the player's total HP left when a battle ends
+
+    /**
+     * @brief Add another set of statistics to this one
+     * @param other The statistics to add
+     */
+    void merge(const BattleStats& other);
+
+    /**
+     * @brief Save the statistics as versioned key=value lines
+     * @param filename The file to save to
+     * @return True if successfully saved
+     */
+    bool saveToFile(const std::string& filename) const;
+
+    /**
+     * @brief Load statistics saved by saveToFile (or the older file of 11 bare numbers)
+     * @param filename The file to load from
+     * @return True if successfully loaded; false for a missing file or a newer version
+     */
+    bool loadFromFile(const std::string& filename);
+
+    /**
+     * @brief Display the statistics
+     * @param out Stream to write to
+     */
+    void display(std::ostream& out) const;
+};
+
+/**
+ * @brief Per-thread statistics, each on its own cache lines, merged on demand
+ *
+ * Every worker updates only its own shard, so counting costs no locks and no
+ * cache line ping-pong. Merge once the workers are done (or otherwise
+ * synchronized with the caller).
+ */
+class StatShards {
+public:
+    /**
+     * @brief Constructor for StatShards
+     * @param count Number of shards (one per thread)
+     */
+    explicit StatShards(size_t count);
+
+    /**
+     * @brief Get a thread's shard
+     * @param index The thread's index
+     * @return The shard
+     */
+    BattleStats& shard(size_t index) { return shards[index].stats; }
+
+    /**
+     * @brief Get the number of shards
+     * @return Shard count
+     */
+    size_t size() const { return shards.size(); }
+
+    /**
+     * @brief Merge every shard
+     * @return The combined statistics
+     */
+    BattleStats merged() const;
+
+private:
+    struct alignas(64) Shard {
+        BattleStats stats;
+    };
+
+    std::vector<Shard> shards;
+};
+
+/**
+ * @brief Sink that counts a battle's events into a set of statistics
+ */
+class StatsEventSink : public BattleEventSink {
+public:
+    /**
+     * @brief Constructor for StatsEventSink
+     * @param target Statistics to count into (must outlive the sink)
+     */
+    explicit StatsEventSink(BattleStats& target);
+
+    void consume(const BattleEvent* events, size_t count) override;
+
+private:
+    BattleStats& stats;
+};
+
+#endif // BATTLE_STATS_H
\ No newline at end of file
@@ -0,0 +1,359 @@
+#include "battle.h"
+#include "metrics.h"
+#include <algorithm>
+#include <sstream>
+
+// Handle one side's turn
+bool Battle::takeTurn(BattleSide side) {
+    bool isPlayer = side == BattleSide::PLAYER;
+    Team& team = isPlayer ? playerTeam : enemyTeam;
+    Team& opposingTeam = isPlayer ? enemyTeam : playerTeam;
+    std::optional<int> activeIndex = team.getFirstAliveIndex();
+    std::optional<int> opposingIndex = opposingTeam.getFirstAliveIndex();
+    if (!activeIndex || !opposingIndex) {
+        return true;    // Nothing left to do once a side is defeated
+    }
+    Pokemon& activePokemon = team.getMember(*activeIndex);
+    Pokemon& opposingPokemon = opposingTeam.getMember(*opposingIndex);
+    
+    // Check for status effects (may prevent action)
+    if (!checkStatusEffects(activePokemon)) {
+        emit(BattleEventType::CANT_MOVE, activePokemon);
+        return true;
+    }
+    
+    // Ask the side's policy what to do, once it has seen everything so far
+    events.flush();
+    DecisionPolicy* policy = isPlayer ? playerPolicy : enemyPolicy;
+    BattleDecision decision;
+    {
+        ScopedTimer timer(Metric::POLICY_DECISION);
+        decision = policy->decide(*this, side);
+    }
+    
+    switch (decision.action) {
+        case BattleAction::FIGHT: {
+            if (decision.moveIndex >= 0 && decision.moveIndex < activePokemon.getMoveCount()) {
+                // A move without PP fails, unless every move is out of PP
+                if (!activePokemon.spendPp(decision.moveIndex) && activePokemon.hasPpLeft()) {
+                    emit(BattleEventType::NO_PP);
+                    break;
+                }
+                int damage = useMove(activePokemon, opposingPokemon, activePokemon.getMove(decision.moveIndex));
+                emit(BattleEventType::DAMAGE, activePokemon, damage);
+                if (damage > 0 && opposingPokemon.isDefeated()) {
+                    emit(BattleEventType::FAINTED, opposingPokemon);
+                }
+            }
+            break;
+        }
+        case BattleAction::ITEM: {
+            if (decision.itemIndex >= 0 && decision.itemIndex < static_cast<int>(team.items.size()) &&
+                decision.pokemonIndex >= 0 && decision.pokemonIndex < team.size()) {
+                // Compare the target before and after to report what the item did
+                const Pokemon& target = team.getMember(decision.pokemonIndex);
+                const Item& item = team.items.getItem(decision.itemIndex);
+                int oldHp = target.hp;
+                StatusEffect oldStatus = target.status;
+                team.useItem(decision.itemIndex, decision.pokemonIndex);
+                
+                BattleEvent event = eventFor(BattleEventType::ITEM_NO_EFFECT, target);
+                event.detail = static_cast<uint8_t>(item.type);
+                if (item.isHealingItem()) {
+                    event.type = BattleEventType::ITEM_HEALED;
+                    event.value = target.hp - oldHp;
+                } else if (item.isStatusHealItem()) {
+                    if (item.healStatus == StatusEffect::NONE || item.healStatus == oldStatus) {
+                        event.type = BattleEventType::ITEM_CURED;
+                        event.status = static_cast<uint8_t>(oldStatus);
+                    }
+                } else if (item.isStatBoostItem()) {
+                    event.type = BattleEventType::ITEM_STAT_ROSE;
+                    event.detail = static_cast<uint8_t>(item.boostStat);
+                } else if (item.isReviveItem() && oldHp == 0) {
+                    event.type = BattleEventType::ITEM_REVIVED;
+                }
+                events.emit(event);
+            }
+            break;
+        }
+        case BattleAction::SWITCH: {
+            if (decision.pokemonIndex >= 0 && decision.pokemonIndex < team.size()) {
+                // Make sure the Pokemon isn't defeated
+                if (team.getMember(decision.pokemonIndex).isDefeated()) {
+                    emit(BattleEventType::SWITCH_FAILED);
+                } else {
+                    // Swap the chosen Pokemon into the active slot
+                    team.swapMembers(*activeIndex, decision.pokemonIndex);
+                    emit(BattleEventType::SWITCH, team.getMember(*activeIndex));
+                    return true;
+                }
+            }
+            break;
+        }
+        case BattleAction::RUN:
+            emit(BattleEventType::RAN_AWAY);
+            return false;
+    }
+    
+    // Check for status recovery at end of turn
+    checkStatusRecovery(activePokemon);
+    
+    return true;
+}
+
+// Use a move
+int Battle::useMove(Pokemon& attacker, Pokemon& defender, MoveId move) {
+    ScopedTimer timer(Metric::USE_MOVE);
+    const MoveRegistry& moves = moveRegistry();
+    if (events.isObserved()) {
+        BattleEvent event = eventFor(BattleEventType::MOVE_USED, attacker);
+        event.move = move;
+        events.emit(event);
+    }
+    
+    // Check if move hits (accuracy and evasion stages included)
+    if (rng.uniformFloat() >= computeHitChance(attacker, defender, move)) {
+        emit(BattleEventType::MISSED);
+        return 0;
+    }
+    
+    // For status moves
+    if (moves.getCategory(move) == MoveCategory::STATUS) {
+        // Apply status effects
+        if (moves.shouldApplyStatus(move, rng)) {
+            inflictStatus(defender, moves.getStatusEffect(move));
+        }
+        
+        // For moves that affect stats (not implemented in this example)
+        return 0;
+    }
+    
+    // Check for type immunity before any damage is dealt
+    float typeEffectiveness = defender.getTypeEffectiveness(moves.getType(move));
+    if (typeEffectiveness == 0.0f) {
+        emit(BattleEventType::NO_EFFECT);
+        return 0;
+    }
+    
+    // Check for critical hit (simplified)
+    bool critical = rng.uniformFloat() < CRITICAL_HIT_CHANCE;
+    
+    // Calculate and apply damage
+    int damage = calculateDamage(attacker, defender, move, critical);
+    setHp(defender, defender.hp - damage);
+    
+    if (critical) {
+        emit(BattleEventType::CRITICAL_HIT, attacker);
+    }
+    
+    if (typeEffectiveness != 1.0f && events.isObserved()) {
+        BattleEvent event = eventFor(BattleEventType::EFFECTIVENESS, defender);
+        event.value = static_cast<int32_t>(typeEffectiveness * 100.0f);
+        events.emit(event);
+    }
+    
+    // Try to apply status effect if the move has one
+    if (moves.shouldApplyStatus(move, rng)) {
+        inflictStatus(defender, moves.getStatusEffect(move));
+    }
+    
+    return damage;
+}
+
+// Calculate damage for a move
+int Battle::calculateDamage(const Pokemon& attacker, const Pokemon& defender, MoveId move, bool critical) {
+    ScopedTimer timer(Metric::CALCULATE_DAMAGE);
+    // Random factor: one of the discrete 85%..100% rolls
+    int roll = rng.uniformInt(DAMAGE_ROLL_MIN, DAMAGE_ROLL_MAX);
+    return computeDamage(attacker, defender, move, environment, difficultyMultiplier, roll, critical);
+}
+
+// Get the exact damage distribution of a move
+DamageDistribution Battle::getDamageDistribution(const Pokemon& attacker, const Pokemon& defender, MoveId move) const {
+    return computeDamageDistribution(attacker, defender, move, environment, difficultyMultiplier);
+}
+
+// Score every move of a Pokemon against a whole team
+DamageMatrix Battle::getDamageMatrix(const Pokemon& attacker, const Team& defenders) const {
+    DefenderBatch batch;
+    for (const Pokemon& defender : defenders.getMembers()) {
+        batch.add(defender);
+    }
+    DamageMatrix matrix;
+    computeDamageMatrix(attacker, batch, environment, difficultyMultiplier, matrix);
+    return matrix;
+}
+
+// Report both active Pokemon at the start of a turn
+void Battle::displayBattleStatus(const Pokemon& playerPokemon, const Pokemon& enemyPokemon) {
+    if (!events.isObserved()) {
+        return;
+    }
+    
+    // Enemy first, as it is drawn at the top
+    for (const Pokemon* pokemon : {&enemyPokemon, &playerPokemon}) {
+        BattleEvent event = eventFor(BattleEventType::POKEMON_STATUS, *pokemon);
+        event.value = pokemon->hp;
+        event.total = pokemon->maxHp;
+        events.emit(event);
+    }
+}
+
+// Check for status effects and apply them
+bool Battle::checkStatusEffects(Pokemon& pokemon) {
+    ScopedTimer timer(Metric::CHECK_STATUS);
+    switch (pokemon.status) {
+        case StatusEffect::PARALYSIS: {
+            // 25% chance to be fully paralyzed
+            if (rng.uniformFloat() < 0.25f) {
+                emit(BattleEventType::STATUS_BLOCKED, pokemon);
+                return false;
+            }
+            break;
+        }
+        case StatusEffect::SLEEP: {
+            // 34% chance to wake up
+            if (rng.uniformFloat() < 0.34f) {
+                emit(BattleEventType::STATUS_CURED, pokemon);
+                pokemon.status = StatusEffect::NONE;
+            } else {
+                emit(BattleEventType::STATUS_BLOCKED, pokemon);
+                return false;
+            }
+            break;
+        }
+        case StatusEffect::FROZEN: {
+            // 20% chance to thaw
+            if (rng.uniformFloat() < 0.2f) {
+                emit(BattleEventType::STATUS_CURED, pokemon);
+                pokemon.status = StatusEffect::NONE;
+            } else {
+                emit(BattleEventType::STATUS_BLOCKED, pokemon);
+                return false;
+            }
+            break;
+        }
+        case StatusEffect::BURN: {
+            // Burn damage
+            int burnDamage = std::max(1, pokemon.maxHp / 16);
+            setHp(pokemon, pokemon.hp - burnDamage);
+            emit(BattleEventType::STATUS_DAMAGE, pokemon, burnDamage);
+            if (pokemon.isDefeated()) {
+                emit(BattleEventType::FAINTED, pokemon);
+            }
+            break;
+        }
+        case StatusEffect::POISON: {
+            // Poison damage
+            int poisonDamage = std::max(1, pokemon.maxHp / 8);
+            setHp(pokemon, pokemon.hp - poisonDamage);
+            emit(BattleEventType::STATUS_DAMAGE, pokemon, poisonDamage);
+            if (pokemon.isDefeated()) {
+                emit(BattleEventType::FAINTED, pokemon);
+            }
+            break;
+        }
+        case StatusEffect::CONFUSION: {
+            // 33% chance to hurt itself in confusion
+            if (rng.uniformFloat() < 0.33f) {
+                int confusionDamage = calculateDamage(pokemon, pokemon, CONFUSION_MOVE_ID, false);
+                setHp(pokemon, pokemon.hp - confusionDamage);
+                emit(BattleEventType::STATUS_DAMAGE, pokemon, confusionDamage);
+                if (pokemon.isDefeated()) {
+                    emit(BattleEventType::FAINTED, pokemon);
+                }
+                return false;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    
+    return !pokemon.isDefeated();  // Can move if not defeated
+}
+
+// Apply a status effect from a move and report it
+void Battle::inflictStatus(Pokemon& pokemon, StatusEffect status) {
+    bool applied = pokemon.status == StatusEffect::NONE;
+    pokemon.applyStatus(status);
+    if (events.isObserved()) {
+        BattleEvent event = eventFor(BattleEventType::STATUS_APPLIED, pokemon);
+        event.detail = applied ? 1 : 0;
+        events.emit(event);
+    }
+}
+
+// Set a Pokemon's HP through its team
+void Battle::setHp(Pokemon& pokemon, int hp) {
+    Team& team = sideOf(pokemon) == BattleSide::PLAYER ? playerTeam : enemyTeam;
+    team.setHp(static_cast<int>(&pokemon - team.getMembers().data()), hp);
+}
+
+// Check for status recovery
+void Battle::checkStatusRecovery(Pokemon& pokemon) {
+    // Some statuses can recover naturally each turn
+    switch (pokemon.status) {
+        case StatusEffect::CONFUSION: {
+            // 33% chance to recover from confusion each turn
+            if (rng.uniformFloat() < 0.33f) {
+                emit(BattleEventType::STATUS_CURED, pokemon);
+                pokemon.status = StatusEffect::NONE;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Generate experience points for defeating a Pokemon
+int Battle::generateExperience(const Pokemon& defeated) {
+    // Simple formula: base exp * level / 7
+    int baseExp = 50;  // Could vary by Pokemon species
+    int experience = baseExp * defeated.level / 7;
+    
+    
+    emit(BattleEventType::EXPERIENCE, defeated, experience);
+    return experience;
+}
+
+// Apply experience to the player's team
+void Battle::applyExperience(int exp) {
+    // Distribute exp among all non-fainted Pokemon
+    int activePokemon = 0;
+    for (const auto& pokemon : playerTeam.getMembers()) {
+        if (!pokemon.isDefeated()) {
+            activePokemon++;
+        }
+    }
+    
+    if (activePokemon == 0) {
+        return;  // No Pokemon to receive exp
+    }
+    
+    // Split exp among active Pokemon
+    int expPerPokemon = exp / activePokemon;
+    
+    for (int i = 0; i < playerTeam.size(); i++) {
+        Pokemon& pokemon = playerTeam.getMember(i);
+        if (!pokemon.isDefeated()) {
+            // Apply experience to this Pokemon
+            int oldLevel = pokemon.level;
+            pokemon.addExperience(expPerPokemon, rng);
+            
+            // Check for level up
+            if (pokemon.level > oldLevel) {
+                emit(BattleEventType::LEVEL_UP, pokemon, pokemon.level);
+                
+                // Check for evolution
+                if (pokemon.canEvolve()) {
+                    emit(BattleEventType::EVOLVING, pokemon);
+                    pokemon.evolve();
+                    emit(BattleEventType::EVOLVED, pokemon);
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
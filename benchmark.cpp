@@ -0,0 +1,507 @@
+#include "battle.h"
+#include "simulator.h"
+#include "damage_calc.h"
+#include "data_loader.h"
+#include "data_generation.h"
+#include "status.h"
+#include "types.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <thread>
+
+// Benchmarks of the hot paths (micro tier) and of whole battles (macro tier)
+//
+// benchmark [--tier micro|macro|all] [--filter text] [--repetitions n] [--min-time ms]
+//           [--output results.json] [--baseline baseline.json] [--threshold fraction]
+//
+// Every benchmark is calibrated to run for at least --min-time per repetition,
+// then repeated; the median time per operation is reported along with its
+// median absolute deviation (MAD) as the noise. With --baseline, a benchmark
+// regressed if its median grew by more than both the threshold and three
+// times the noise of either run; the exit code is then 1.
+
+namespace {
+
+constexpr const char* RESULTS_FORMAT = "pokemon-benchmark";
+constexpr int RESULTS_VERSION = 1;
+
+// Standard deviations of noise a change must exceed to count
+constexpr double NOISE_SIGMAS = 3.0;
+
+// Scales a MAD to the standard deviation of normally distributed samples
+constexpr double MAD_TO_SIGMA = 1.4826;
+
+// Results go here so the compiler can't drop the work that produced them
+volatile uint64_t sink = 0;
+
+struct Options {
+    std::string tier = "all";
+    std::string filter;
+    int repetitions = 7;
+    double minTimeMs = 50.0;
+    std::string output;
+    std::string baseline;
+    double threshold = 0.10;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    std::string tier;
+    double median = 0.0;        // Nanoseconds per operation
+    double mad = 0.0;
+    double best = 0.0;
+    uint64_t iterations = 0;    // Operations per repetition
+    int repetitions = 0;
+};
+
+// Runs the given number of operations
+using BenchmarkBody = std::function<void(uint64_t iterations)>;
+
+struct Benchmark {
+    std::string name;
+    std::string tier;
+    BenchmarkBody body;
+};
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+// Time one run of the body, in nanoseconds
+double timeRun(const BenchmarkBody& body, uint64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    body(iterations);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Calibrate, then time the repetitions
+BenchmarkResult measure(const Benchmark& benchmark, const Options& options) {
+    uint64_t iterations = 1;
+    while (timeRun(benchmark.body, iterations) < options.minTimeMs * 1e6 && iterations < (uint64_t(1) << 40)) {
+        iterations *= 2;
+    }
+
+    std::vector<double> perOperation;
+    for (int i = 0; i < options.repetitions; i++) {
+        perOperation.push_back(timeRun(benchmark.body, iterations) / static_cast<double>(iterations));
+    }
+
+    BenchmarkResult result;
+    result.name = benchmark.name;
+    result.tier = benchmark.tier;
+    result.median = median(perOperation);
+    std::vector<double> deviations;
+    for (double value : perOperation) {
+        deviations.push_back(std::fabs(value - result.median));
+    }
+    result.mad = median(deviations);
+    result.best = *std::min_element(perOperation.begin(), perOperation.end());
+    result.iterations = iterations;
+    result.repetitions = options.repetitions;
+    return result;
+}
+
+// A Pokemon with four moves, built in code so results don't depend on the data files
+Pokemon makePokemon(const std::string& name, int offset, PokemonType primary, PokemonType secondary) {
+    Pokemon pokemon(name, 100 + offset * 5, 55 + offset, 45, 50 + offset, 50, 60 + offset * 7, primary, secondary);
+    pokemon.addMove(Move("Tackle", PokemonType::NORMAL, MoveCategory::PHYSICAL, 40, 100, 35, StatusEffect::NONE, 0));
+    pokemon.addMove(Move("Strike " + typeToString(primary), primary, MoveCategory::SPECIAL, 90, 85, 15,
+                         StatusEffect::BURN, 10));
+    pokemon.addMove(Move("Zap", PokemonType::ELECTRIC, MoveCategory::SPECIAL, 60, 100, 15, StatusEffect::PARALYSIS, 30));
+    pokemon.addMove(Move("Quake", PokemonType::GROUND, MoveCategory::PHYSICAL, 80, 95, 10, StatusEffect::NONE, 0));
+    return pokemon;
+}
+
+// A team of the given size
+Team makeTeam(int size) {
+    static const PokemonType types[] = {PokemonType::FIRE, PokemonType::WATER, PokemonType::GRASS,
+                                        PokemonType::ELECTRIC, PokemonType::ROCK, PokemonType::PSYCHIC};
+    Team team;
+    for (int i = 0; i < size; i++) {
+        team.addPokemon(makePokemon("Bench" + std::to_string(i), i, types[i], types[(i + 3) % 6]));
+    }
+    return team;
+}
+
+// Publish a generation holding every species and move the benchmarks build, so the
+// simulator's worker threads (which read the published generation) know them too
+void publishBenchmarkData() {
+    std::shared_ptr<DataGeneration> next = std::make_shared<DataGeneration>(*DataGeneration::current());
+    {
+        GenerationPin pin(next);
+        makeTeam(6);
+        makePokemon("Attacker", 1, PokemonType::FIRE, PokemonType::NONE);
+        makePokemon("Defender", 0, PokemonType::WATER, PokemonType::FLYING);
+    }
+    DataGeneration::publish(next);
+}
+
+// Fight battles between copies of two teams
+void fightBattles(const Team& player, const Team& enemy, uint64_t count) {
+    Environment environment(BattleEnvironment::NORMAL);
+    RandomMovePolicy playerPolicy(1);
+    RandomMovePolicy enemyPolicy(2);
+    for (uint64_t i = 0; i < count; i++) {
+        Team playerCopy = player;
+        Team enemyCopy = enemy;
+        Battle battle(playerCopy, enemyCopy, 1.0f, environment, playerPolicy, enemyPolicy, i);
+        sink = sink + (battle.start() ? 1 : 0);
+    }
+}
+
+std::vector<Benchmark> microBenchmarks() {
+    std::vector<Benchmark> benchmarks;
+
+    benchmarks.push_back({"type_effectiveness", "micro", [](uint64_t iterations) {
+        Pokemon defender = makePokemon("Defender", 0, PokemonType::WATER, PokemonType::FLYING);
+        uint64_t total = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            PokemonType attack = static_cast<PokemonType>(i % TYPE_COUNT);
+            total += static_cast<uint64_t>(defender.getTypeEffectiveness(attack) * 4.0f);
+        }
+        sink = sink + total;
+    }});
+
+    benchmarks.push_back({"calculate_damage", "micro", [](uint64_t iterations) {
+        Pokemon attacker = makePokemon("Attacker", 1, PokemonType::FIRE, PokemonType::NONE);
+        Pokemon defender = makePokemon("Defender", 2, PokemonType::GRASS, PokemonType::STEEL);
+        Environment environment(BattleEnvironment::NORMAL);
+        uint64_t total = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            MoveId move = attacker.getMove(static_cast<int>(i % Pokemon::MAX_MOVES));
+            int roll = DAMAGE_ROLL_MIN + static_cast<int>(i % (DAMAGE_ROLL_MAX - DAMAGE_ROLL_MIN + 1));
+            total += static_cast<uint64_t>(computeDamage(attacker, defender, move, environment, 1.0f, roll, (i & 15) == 0));
+        }
+        sink = sink + total;
+    }});
+
+    // Every move of one attacker against a full opposing team, one matrix per iteration
+    benchmarks.push_back({"damage_matrix", "micro", [](uint64_t iterations) {
+        Pokemon attacker = makePokemon("Attacker", 1, PokemonType::FIRE, PokemonType::NONE);
+        Team defenders = makeTeam(6);
+        Environment environment(BattleEnvironment::NORMAL);
+        DefenderBatch batch;
+        for (const Pokemon& defender : defenders.getMembers()) {
+            batch.add(defender);
+        }
+        DamageMatrix matrix;
+        float total = 0.0f;
+        for (uint64_t i = 0; i < iterations; i++) {
+            computeDamageMatrix(attacker, batch, environment, 1.0f, matrix);
+            total += matrix.expectedDamage[i % Pokemon::MAX_MOVES][i % 6];
+        }
+        sink = sink + static_cast<uint64_t>(total);
+    }});
+
+    // The same scores one pairing at a time: every roll through the scalar computeDamage
+    benchmarks.push_back({"damage_matrix_scalar", "micro", [](uint64_t iterations) {
+        Pokemon attacker = makePokemon("Attacker", 1, PokemonType::FIRE, PokemonType::NONE);
+        Team defenders = makeTeam(6);
+        Environment environment(BattleEnvironment::NORMAL);
+        double total = 0.0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            for (int m = 0; m < attacker.getMoveCount(); m++) {
+                MoveId move = attacker.getMove(m);
+                for (const Pokemon& defender : defenders.getMembers()) {
+                    int normal = 0;
+                    int critical = 0;
+                    for (int roll = DAMAGE_ROLL_MIN; roll <= DAMAGE_ROLL_MAX; roll++) {
+                        normal += computeDamage(attacker, defender, move, environment, 1.0f, roll, false);
+                        critical += computeDamage(attacker, defender, move, environment, 1.0f, roll, true);
+                    }
+                    total += computeHitChance(attacker, defender, move) *
+                             ((1.0 - CRITICAL_HIT_CHANCE) * normal + CRITICAL_HIT_CHANCE * critical) / DAMAGE_ROLL_COUNT;
+                }
+            }
+        }
+        sink = sink + static_cast<uint64_t>(total);
+    }});
+
+    benchmarks.push_back({"apply_status_effect", "micro", [](uint64_t iterations) {
+        static const StatusEffect statuses[] = {StatusEffect::BURN, StatusEffect::POISON, StatusEffect::PARALYSIS,
+                                                StatusEffect::SLEEP, StatusEffect::FROZEN, StatusEffect::CONFUSION};
+        Rng rng(3);
+        int hp = 100;
+        uint64_t total = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            bool canMove = true;
+            std::string message = applyStatusEffect(statuses[i % 6], canMove, hp, 100, rng);
+            total += message.size() + (canMove ? 1 : 0);
+            if (hp <= 0) {
+                hp = 100;
+            }
+        }
+        sink = sink + total;
+    }});
+
+    benchmarks.push_back({"team_is_defeated", "micro", [](uint64_t iterations) {
+        // Worst case: only the last member can still battle
+        Team team = makeTeam(6);
+        for (int i = 0; i < 5; i++) {
+            team.setHp(i, 0);
+        }
+        uint64_t total = 0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            total += team.isDefeated() ? 1 : 0;
+            team.setHp(5, static_cast<int>(i & 1) + 1);
+        }
+        sink = sink + total;
+    }});
+
+    // The loaders parse the shipped data files; skipped when they aren't in the working directory
+    struct DataFile {
+        const char* benchmark;
+        const char* file;
+        std::function<size_t(const std::string&)> load;
+    };
+    const DataFile files[] = {
+        {"load_pokemon", "pokemon.csv", [](const std::string& file) { return DataLoader::loadPokemon(file).size(); }},
+        {"load_moves", "moves.csv", [](const std::string& file) { return DataLoader::loadMoves(file).size(); }},
+        {"load_items", "items.csv", [](const std::string& file) { return DataLoader::loadItems(file).size(); }},
+    };
+    for (const DataFile& data : files) {
+        if (!std::ifstream(data.file).good()) {
+            std::cerr << "Skipping " << data.benchmark << ": " << data.file << " not found" << std::endl;
+            continue;
+        }
+        std::string file = data.file;
+        auto load = data.load;
+        benchmarks.push_back({data.benchmark, "micro", [file, load](uint64_t iterations) {
+            // Parsed into a scratch generation, since the published one can't change
+            GenerationPin scratch(std::make_shared<DataGeneration>());
+            for (uint64_t i = 0; i < iterations; i++) {
+                sink = sink + load(file);
+            }
+        }});
+    }
+
+    return benchmarks;
+}
+
+std::vector<Benchmark> macroBenchmarks() {
+    std::vector<Benchmark> benchmarks;
+
+    benchmarks.push_back({"battle_1v1", "macro", [](uint64_t iterations) {
+        fightBattles(makeTeam(1), makeTeam(1), iterations);
+    }});
+
+    benchmarks.push_back({"battle_6v6", "macro", [](uint64_t iterations) {
+        fightBattles(makeTeam(6), makeTeam(6), iterations);
+    }});
+
+    // Simulator throughput from 1 thread up to the hardware's thread count, in powers of two
+    int hardwareThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < hardwareThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+    for (int threads : threadCounts) {
+        benchmarks.push_back({"simulator_threads_" + std::to_string(threads), "macro", [threads](uint64_t iterations) {
+            MatchupSimulator simulator(makeTeam(6), makeTeam(6), Environment(BattleEnvironment::NORMAL));
+            SimulationConfig config;
+            config.battles = static_cast<int>(iterations);
+            config.threads = threads;
+            config.seed = 7;
+            config.batchSize = 16;
+            config.collectStats = false;
+            sink = sink + static_cast<uint64_t>(simulator.run(config).playerWins);
+        }});
+    }
+
+    return benchmarks;
+}
+
+// Write results as JSON, one benchmark per line
+bool writeResults(const std::string& filename, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "{\n  \"format\": \"" << RESULTS_FORMAT << "\",\n  \"version\": " << RESULTS_VERSION
+         << ",\n  \"benchmarks\": [\n";
+    file << std::setprecision(6);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        file << "    {\"name\": \"" << result.name << "\", \"tier\": \"" << result.tier
+             << "\", \"unit\": \"ns/op\", \"median\": " << result.median << ", \"mad\": " << result.mad
+             << ", \"min\": " << result.best << ", \"iterations\": " << result.iterations
+             << ", \"repetitions\": " << result.repetitions << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+// Find "key": in a line and return what follows it
+std::string fieldOf(const std::string& line, const std::string& key) {
+    std::string marker = "\"" + key + "\": ";
+    size_t start = line.find(marker);
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += marker.size();
+    if (start < line.size() && line[start] == '"') {
+        size_t end = line.find('"', start + 1);
+        return end == std::string::npos ? "" : line.substr(start + 1, end - start - 1);
+    }
+    size_t end = line.find_first_of(",}", start);
+    return line.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+// Read results written by writeResults
+bool readResults(const std::string& filename, std::map<std::string, BenchmarkResult>& results) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string line;
+    bool formatSeen = false;
+    while (std::getline(file, line)) {
+        if (fieldOf(line, "format") == RESULTS_FORMAT) {
+            formatSeen = true;
+        }
+        std::string name = fieldOf(line, "name");
+        if (name.empty()) {
+            continue;
+        }
+        try {
+            BenchmarkResult result;
+            result.name = name;
+            result.tier = fieldOf(line, "tier");
+            result.median = std::stod(fieldOf(line, "median"));
+            result.mad = std::stod(fieldOf(line, "mad"));
+            results[name] = result;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return formatSeen;
+}
+
+// Compare against a baseline; returns the number of regressions
+int compare(const std::vector<BenchmarkResult>& results, const std::map<std::string, BenchmarkResult>& baseline,
+            double threshold) {
+    int regressions = 0;
+    std::cout << "\nCompared with the baseline (threshold " << threshold * 100.0 << "%, "
+              << NOISE_SIGMAS << " sigma of noise):\n";
+    for (const BenchmarkResult& result : results) {
+        auto found = baseline.find(result.name);
+        if (found == baseline.end()) {
+            std::cout << "  " << std::left << std::setw(24) << result.name << "new\n";
+            continue;
+        }
+        const BenchmarkResult& base = found->second;
+        double noise = NOISE_SIGMAS * MAD_TO_SIGMA * std::max(base.mad, result.mad);
+        double allowed = std::max(threshold * base.median, noise);
+        double change = base.median > 0.0 ? (result.median - base.median) / base.median * 100.0 : 0.0;
+
+        const char* verdict = "unchanged";
+        if (result.median - base.median > allowed) {
+            verdict = "REGRESSED";
+            regressions++;
+        } else if (base.median - result.median > allowed) {
+            verdict = "improved";
+        }
+        std::cout << "  " << std::left << std::setw(24) << result.name << std::right << std::showpos
+                  << std::fixed << std::setprecision(1) << std::setw(7) << change << "%" << std::noshowpos
+                  << "  " << verdict << "\n";
+    }
+    return regressions;
+}
+
+void printUsage() {
+    std::cerr << "Usage: benchmark [--tier micro|macro|all] [--filter text] [--repetitions n] [--min-time ms]\n"
+                 "                 [--output results.json] [--baseline baseline.json] [--threshold fraction]"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 2;
+        }
+        std::string value = argv[++i];
+        try {
+            if (option == "--tier") {
+                options.tier = value;
+            } else if (option == "--filter") {
+                options.filter = value;
+            } else if (option == "--repetitions") {
+                options.repetitions = std::max(1, std::stoi(value));
+            } else if (option == "--min-time") {
+                options.minTimeMs = std::stod(value);
+            } else if (option == "--output") {
+                options.output = value;
+            } else if (option == "--baseline") {
+                options.baseline = value;
+            } else if (option == "--threshold") {
+                options.threshold = std::stod(value);
+            } else {
+                printUsage();
+                return 2;
+            }
+        } catch (const std::exception&) {
+            printUsage();
+            return 2;
+        }
+    }
+    if (options.tier != "micro" && options.tier != "macro" && options.tier != "all") {
+        printUsage();
+        return 2;
+    }
+
+    publishBenchmarkData();
+    std::vector<Benchmark> benchmarks;
+    if (options.tier != "macro") {
+        benchmarks = microBenchmarks();
+    }
+    if (options.tier != "micro") {
+        std::vector<Benchmark> macro = macroBenchmarks();
+        benchmarks.insert(benchmarks.end(), macro.begin(), macro.end());
+    }
+
+    std::vector<BenchmarkResult> results;
+    std::cout << std::left << std::setw(24) << "benchmark" << std::right << std::setw(14) << "ns/op"
+              << std::setw(12) << "+/- (MAD)" << std::setw(16) << "ops/s" << "\n";
+    for (const Benchmark& benchmark : benchmarks) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        BenchmarkResult result = measure(benchmark, options);
+        results.push_back(result);
+        std::cout << std::left << std::setw(24) << result.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << result.median << std::setw(12) << result.mad
+                  << std::setw(16) << std::setprecision(0) << 1e9 / result.median << std::endl;
+    }
+
+    if (!options.output.empty() && !writeResults(options.output, results)) {
+        std::cerr << "Could not write " << options.output << std::endl;
+        return 2;
+    }
+
+    if (!options.baseline.empty()) {
+        std::map<std::string, BenchmarkResult> baseline;
+        if (!readResults(options.baseline, baseline)) {
+            std::cerr << "Could not read the baseline " << options.baseline << std::endl;
+            return 2;
+        }
+        if (compare(results, baseline, options.threshold) > 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "csv_reader.h"
+#include <charconv>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Trim blanks off both ends of a field
+std::string_view trim(std::string_view text) {
+    size_t start = text.find_first_not_of(" \t");
+    if (start == std::string_view::npos) {
+        return std::string_view();
+    }
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(start, end - start + 1);
+}
+
+} // namespace
+
+// Constructor for CsvParseError
+CsvParseError::CsvParseError(size_t errorLine, size_t errorColumn, const std::string& errorMessage,
+                             const std::string& filename)
+    : std::runtime_error((filename.empty() ? "line " : filename + ":") + std::to_string(errorLine) +
+                         (errorColumn > 0 ? (filename.empty() ? ", column " : ":") + std::to_string(errorColumn)
+                                          : std::string()) +
+                         ": " + errorMessage),
+      line(errorLine), column(errorColumn), message(errorMessage) {
+}
+
+// Copy of the error moved down by some lines
+CsvParseError CsvParseError::shifted(size_t lines, const std::string& filename) const {
+    return CsvParseError(line + lines, column, message, filename);
+}
+
+// Open and map a file
+MappedFile::MappedFile(const std::string& filename) : bytes(nullptr), length(0), mapped(false) {
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + filename);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* address = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            ::madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            bytes = static_cast<const char*>(address);
+            length = static_cast<size_t>(info.st_size);
+            mapped = true;
+        }
+    }
+    ::close(fd);
+    if (mapped) {
+        return;
+    }
+#endif
+    // Fall back to reading the whole file once
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open " + filename);
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+}
+
+// Unmap the file
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped) {
+        ::munmap(const_cast<char*>(bytes), length);
+    }
+#endif
+}
+
+// Split a line into fields
+CsvRow::CsvRow(std::string_view text, size_t number) : line(text), count(0), lineNumber(number) {
+    size_t start = 0;
+    while (true) {
+        size_t comma = text.find(',', start);
+        size_t end = comma == std::string_view::npos ? text.size() : comma;
+        if (count == MAX_FIELDS) {
+            throw CsvParseError(lineNumber, start + 1, "too many fields");
+        }
+        fields[count++] = trim(text.substr(start, end - start));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+}
+
+// Parse a field as a whole decimal number
+int CsvRow::integer(size_t index) const {
+    std::string_view text = field(index);
+    int value = 0;
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if (!text.empty() && *first == '+') {
+        ++first;
+    }
+    std::from_chars_result result = std::from_chars(first, last, value);
+    if (text.empty() || result.ec != std::errc() || result.ptr != last) {
+        fail(index, "expected a number, found \"" + std::string(text) + "\"");
+    }
+    return value;
+}
+
+// Parse an optional number field
+int CsvRow::integer(size_t index, int fallback) const {
+    return field(index).empty() ? fallback : integer(index);
+}
+
+// Require a field count
+void CsvRow::expectFields(size_t minimum, size_t maximum) const {
+    if (count < minimum || count > maximum) {
+        std::string expected = minimum == maximum ? std::to_string(minimum)
+                                                  : std::to_string(minimum) + " to " + std::to_string(maximum);
+        throw CsvParseError(lineNumber, 0, "expected " + expected + " fields, found " + std::to_string(count));
+    }
+}
+
+// Throw an error pointing at a field
+void CsvRow::fail(size_t index, const std::string& message) const {
+    size_t column = 0;
+    if (index < count) {
+        column = static_cast<size_t>(fields[index].data() - line.data()) + 1;
+    } else {
+        column = line.size() + 1;
+    }
+    throw CsvParseError(lineNumber, column, message);
+}
+
+// Check if a line holds no data
+bool isCsvCommentLine(std::string_view line) {
+    size_t start = line.find_first_not_of(" \t\r");
+    return start == std::string_view::npos || line[start] == '#';
+}
\ No newline at end of file
@@ -0,0 +1,281 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+
+/**
+ * @brief Error in a data file, with the line and column it was found at
+ */
+class CsvParseError : public std::runtime_error {
+public:
+    /**
+     * @brief Constructor for CsvParseError
+     * @param errorLine Line number (1-based)
+     * @param errorColumn Column number (1-based, 0 if the whole line is at fault)
+     * @param errorMessage What is wrong
+     * @param filename File the error is in (empty if not known yet)
+     */
+    CsvParseError(size_t errorLine, size_t errorColumn, const std::string& errorMessage,
+                  const std::string& filename = std::string());
+
+    /**
+     * @brief Get the line the error was found on
+     * @return Line number (1-based)
+     */
+    size_t getLine() const { return line; }
+
+    /**
+     * @brief Get the column the error was found at
+     * @return Column number (1-based, 0 if the whole line is at fault)
+     */
+    size_t getColumn() const { return column; }
+
+    /**
+     * @brief Get the error without its position
+     * @return The message
+     */
+    const std::string& getMessage() const { return message; }
+
+    /**
+     * @brief Copy of the error moved down by some lines (for errors found in a chunk)
+     * @param lines Number of lines before the chunk
+     * @param filename File the error is in
+     * @return The shifted error
+     */
+    CsvParseError shifted(size_t lines, const std::string& filename) const;
+
+private:
+    size_t line;
+    size_t column;
+    std::string message;
+};
+
+/**
+ * @brief Read-only view of a whole file, memory mapped where the platform allows
+ *
+ * On POSIX systems the file is mapped with mmap and never copied; elsewhere it
+ * is read into a buffer once.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Open and map a file
+     * @param filename The file to map
+     * @throws std::runtime_error if the file can't be opened
+     */
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Get the file's contents
+     * @return View of every byte of the file
+     */
+    std::string_view data() const { return std::string_view(bytes, length); }
+
+private:
+    const char* bytes;
+    size_t length;
+    bool mapped;
+    std::vector<char> buffer;   // Holds the contents when the file isn't mapped
+};
+
+/**
+ * @brief The comma separated fields of one data line, as views into the file
+ */
+class CsvRow {
+public:
+    static constexpr size_t MAX_FIELDS = 16;
+
+    /**
+     * @brief Split a line into fields; surrounding blanks are trimmed off each field
+     * @param text The line, without its line break
+     * @param lineNumber Line number used in errors
+     */
+    CsvRow(std::string_view text, size_t lineNumber);
+
+    /**
+     * @brief Get the number of fields
+     * @return Field count
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Get a field
+     * @param index Field index
+     * @return The field's text (empty for fields past the end of the line)
+     */
+    std::string_view field(size_t index) const { return index < count ? fields[index] : std::string_view(); }
+
+    /**
+     * @brief Get a field as a string
+     * @param index Field index
+     * @return Copy of the field's text
+     */
+    std::string text(size_t index) const { return std::string(field(index)); }
+
+    /**
+     * @brief Parse a field as a whole decimal number, without any locale
+     * @param index Field index
+     * @return The number
+     * @throws CsvParseError pointing at the field if it isn't a number
+     */
+    int integer(size_t index) const;
+
+    /**
+     * @brief Parse an optional number field
+     * @param index Field index
+     * @param fallback Value of an empty or missing field
+     * @return The number
+     */
+    int integer(size_t index, int fallback) const;
+
+    /**
+     * @brief Require a field count
+     * @param minimum Fewest fields allowed
+     * @param maximum Most fields allowed
+     * @throws CsvParseError if the line has a different number of fields
+     */
+    void expectFields(size_t minimum, size_t maximum) const;
+
+    /**
+     * @brief Throw an error pointing at a field
+     * @param index Field index
+     * @param message What is wrong
+     */
+    [[noreturn]] void fail(size_t index, const std::string& message) const;
+
+private:
+    std::string_view line;
+    std::string_view fields[MAX_FIELDS];
+    size_t count;
+    size_t lineNumber;
+};
+
+/**
+ * @brief Check if a line holds no data (blank or a # comment)
+ * @param line The line
+ * @return True if the line should be skipped
+ */
+bool isCsvCommentLine(std::string_view line);
+
+/**
+ * @brief Parses every data line of a chunk of a data file
+ * @param chunk The chunk (starts at the beginning of a line)
+ * @param parse Converts a CsvRow to a row object
+ * @param rows Receives the parsed rows
+ * @return Number of lines in the chunk
+ * @throws CsvParseError with line numbers counted from the chunk's start
+ */
+template <typename Row, typename Parser>
+size_t parseCsvChunk(std::string_view chunk, const Parser& parse, std::vector<Row>& rows) {
+    size_t lineNumber = 0;
+    size_t position = 0;
+    while (position < chunk.size()) {
+        size_t end = chunk.find('\n', position);
+        if (end == std::string_view::npos) {
+            end = chunk.size();
+        }
+        std::string_view line = chunk.substr(position, end - position);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        ++lineNumber;
+        if (!isCsvCommentLine(line)) {
+            rows.push_back(parse(CsvRow(line, lineNumber)));
+        }
+        position = end + 1;
+    }
+    return lineNumber;
+}
+
+/**
+ * @brief Bytes below which a file is parsed on the calling thread only
+ */
+constexpr size_t CSV_MIN_CHUNK_BYTES = size_t(1) << 20;
+
+/**
+ * @brief Parses a whole data file, splitting big files into chunks parsed on several threads
+ * @param data The file's contents
+ * @param filename File name for error messages
+ * @param parse Converts a CsvRow to a row object; must be safe to call from several threads
+ * @return The rows in file order
+ * @throws CsvParseError for the first bad line of the file
+ */
+template <typename Row, typename Parser>
+std::vector<Row> parseCsv(std::string_view data, const std::string& filename, const Parser& parse) {
+    size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t chunkCount = std::max<size_t>(1, std::min(hardwareThreads, data.size() / CSV_MIN_CHUNK_BYTES));
+
+    // Chunk boundaries fall just after a line break
+    std::vector<size_t> bounds(1, 0);
+    for (size_t i = 1; i < chunkCount; ++i) {
+        size_t split = data.find('\n', std::max(bounds.back(), data.size() * i / chunkCount));
+        if (split == std::string_view::npos) {
+            break;
+        }
+        bounds.push_back(split + 1);
+    }
+    bounds.push_back(data.size());
+    chunkCount = bounds.size() - 1;
+
+    std::vector<std::vector<Row>> chunkRows(chunkCount);
+    std::vector<size_t> chunkLines(chunkCount, 0);
+    std::vector<std::exception_ptr> errors(chunkCount);
+    auto work = [&](size_t chunk) {
+        try {
+            chunkLines[chunk] = parseCsvChunk(data.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]),
+                                              parse, chunkRows[chunk]);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+        workers.emplace_back(work, chunk);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Report the first error in the file, with its line counted from the top
+    size_t linesBefore = 0;
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        if (errors[chunk]) {
+            try {
+                std::rethrow_exception(errors[chunk]);
+            } catch (const CsvParseError& error) {
+                throw error.shifted(linesBefore, filename);
+            }
+        }
+        linesBefore += chunkLines[chunk];
+    }
+
+    if (chunkCount == 1) {
+        return std::move(chunkRows[0]);
+    }
+    size_t total = 0;
+    for (const auto& rows : chunkRows) {
+        total += rows.size();
+    }
+    std::vector<Row> result;
+    result.reserve(total);
+    for (auto& rows : chunkRows) {
+        std::move(rows.begin(), rows.end(), std::back_inserter(result));
+    }
+    return result;
+}
+
+#endif // CSV_READER_H
\ No newline at end of file
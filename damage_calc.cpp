@@ -0,0 +1,328 @@
+#include "damage_calc.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// The random factor of every roll, as computeDamage derives it
+constexpr std::array<float, DAMAGE_ROLL_COUNT> makeRollFactors() {
+    std::array<float, DAMAGE_ROLL_COUNT> factors{};
+    for (int roll = 0; roll < DAMAGE_ROLL_COUNT; ++roll) {
+        factors[roll] = (DAMAGE_ROLL_MIN + roll) / 100.0f;
+    }
+    return factors;
+}
+
+constexpr std::array<float, DAMAGE_ROLL_COUNT> ROLL_FACTORS = makeRollFactors();
+
+// What one move puts into every column of its damage matrix row
+struct MoveRow {
+    double numerator;                                       // ((2 * level) / 5 + 2) * power * staged attack
+    const double* defense;                                  // The defender stat the move hits, per column
+    float stab;
+    float environmentBoost;
+    float accuracy;                                         // Accuracy as a fraction
+    alignas(16) float effectiveness[DAMAGE_MATRIX_TARGETS]; // 0 for immune and unused columns, and status moves
+};
+
+#if defined(__SSE2__)
+
+// Score one move against four columns at a time
+void scoreRow(const MoveRow& row, const float* accuracyMultipliers, float difficulty, float* hitRow, float* damageRow) {
+    const __m128d numerator = _mm_set1_pd(row.numerator);
+    const __m128d fifty = _mm_set1_pd(50.0);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 difficultyFactor = _mm_set1_ps(difficulty);
+    for (int column = 0; column < DAMAGE_MATRIX_TARGETS; column += 4) {
+        // Base damage: the integer formula is exact in double precision, and truncating once equals dividing twice
+        __m128d low = _mm_div_pd(numerator, _mm_mul_pd(_mm_load_pd(row.defense + column), fifty));
+        __m128d high = _mm_div_pd(numerator, _mm_mul_pd(_mm_load_pd(row.defense + column + 2), fifty));
+        __m128i base = _mm_unpacklo_epi64(_mm_cvttpd_epi32(low), _mm_cvttpd_epi32(high));
+        base = _mm_add_epi32(base, _mm_set1_epi32(2));
+
+        // Same multiplication order as computeDamage, so each roll truncates to the same value
+        __m128 effectiveness = _mm_load_ps(row.effectiveness + column);
+        __m128 scaled = _mm_mul_ps(_mm_cvtepi32_ps(base), _mm_set1_ps(row.stab));
+        scaled = _mm_mul_ps(_mm_mul_ps(scaled, effectiveness), _mm_set1_ps(row.environmentBoost));
+
+        __m128 sums[2];
+        for (int crit = 0; crit < 2; ++crit) {
+            __m128 boosted = _mm_mul_ps(scaled, _mm_set1_ps(crit ? CRITICAL_HIT_MULTIPLIER : 1.0f));
+            __m128 sum = zero;
+            for (float factor : ROLL_FACTORS) {
+                __m128 damage = _mm_mul_ps(_mm_mul_ps(boosted, _mm_set1_ps(factor)), difficultyFactor);
+                sum = _mm_add_ps(sum, _mm_max_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(damage)), one));
+            }
+            sums[crit] = sum;
+        }
+
+        __m128 hitChance = _mm_mul_ps(_mm_set1_ps(row.accuracy), _mm_load_ps(accuracyMultipliers + column));
+        hitChance = _mm_min_ps(one, _mm_max_ps(zero, hitChance));
+        __m128 meanDamage = _mm_add_ps(_mm_mul_ps(sums[0], _mm_set1_ps(1.0f - CRITICAL_HIT_CHANCE)),
+                                       _mm_mul_ps(sums[1], _mm_set1_ps(CRITICAL_HIT_CHANCE)));
+        meanDamage = _mm_mul_ps(meanDamage, _mm_set1_ps(1.0f / DAMAGE_ROLL_COUNT));
+        __m128 hits = _mm_cmpneq_ps(effectiveness, zero);
+        _mm_store_ps(hitRow + column, hitChance);
+        _mm_store_ps(damageRow + column, _mm_and_ps(hits, _mm_mul_ps(hitChance, meanDamage)));
+    }
+}
+
+#else
+
+// Score one move against every column
+void scoreRow(const MoveRow& row, const float* accuracyMultipliers, float difficulty, float* hitRow, float* damageRow) {
+    for (int column = 0; column < DAMAGE_MATRIX_TARGETS; ++column) {
+        int base = static_cast<int>(row.numerator / (row.defense[column] * 50.0)) + 2;
+        float scaled = base * row.stab * row.effectiveness[column] * row.environmentBoost;
+
+        float sums[2];
+        for (int crit = 0; crit < 2; ++crit) {
+            float boosted = scaled * (crit ? CRITICAL_HIT_MULTIPLIER : 1.0f);
+            float sum = 0.0f;
+            for (float factor : ROLL_FACTORS) {
+                sum += std::max(1, static_cast<int>(boosted * factor * difficulty));
+            }
+            sums[crit] = sum;
+        }
+
+        float hitChance = std::min(1.0f, std::max(0.0f, row.accuracy * accuracyMultipliers[column]));
+        float meanDamage = (sums[0] * (1.0f - CRITICAL_HIT_CHANCE) + sums[1] * CRITICAL_HIT_CHANCE) *
+                           (1.0f / DAMAGE_ROLL_COUNT);
+        hitRow[column] = hitChance;
+        damageRow[column] = row.effectiveness[column] != 0.0f ? hitChance * meanDamage : 0.0f;
+    }
+}
+
+#endif
+
+} // namespace
+
+// Constructor: every column starts unused
+DefenderBatch::DefenderBatch() : evasionStage(), profiles() {
+    std::fill(defense, defense + DAMAGE_MATRIX_TARGETS, 1.0);
+    std::fill(specialDefense, specialDefense + DAMAGE_MATRIX_TARGETS, 1.0);
+}
+
+// Add a defender as the next column
+bool DefenderBatch::add(const Pokemon& defender) {
+    if (count == DAMAGE_MATRIX_TARGETS) {
+        return false;
+    }
+    defense[count] = std::max(1, static_cast<int>(defender.defense *
+                                                  getStatStageMultiplier(defender.getStatStage(Stat::DEFENSE))));
+    specialDefense[count] = std::max(1, static_cast<int>(defender.specialDefense *
+                                                         getStatStageMultiplier(defender.getStatStage(Stat::SPECIAL_DEFENSE))));
+    evasionStage[count] = static_cast<int8_t>(defender.getStatStage(Stat::EVASION));
+    profiles[count] = defender.defensiveProfile;
+    count++;
+    return true;
+}
+
+// Calculate the damage of one hit for a fixed roll
+int computeDamage(const Pokemon& attacker, const Pokemon& defender, MoveId move,
+                  const Environment& environment, float difficulty, int rollPercent, bool critical) {
+    const MoveRegistry& moves = moveRegistry();
+    MoveCategory category = moves.getCategory(move);
+    PokemonType moveType = moves.getType(move);
+    
+    // No damage for status moves
+    if (category == MoveCategory::STATUS) {
+        return 0;
+    }
+    
+    // Type effectiveness (immune defenders take nothing)
+    float typeEffectiveness = defender.getTypeEffectiveness(moveType);
+    if (typeEffectiveness == 0.0f) {
+        return 0;
+    }
+    
+    // Base damage
+    bool physical = category == MoveCategory::PHYSICAL;
+    int attack = physical ? attacker.attack : attacker.specialAttack;
+    int defense = physical ? defender.defense : defender.specialDefense;
+    
+    // Apply stat stage modifiers
+    int attackStage = attacker.getStatStage(physical ? Stat::ATTACK : Stat::SPECIAL_ATTACK);
+    int defenseStage = defender.getStatStage(physical ? Stat::DEFENSE : Stat::SPECIAL_DEFENSE);
+    attack = static_cast<int>(attack * getStatStageMultiplier(attackStage));
+    defense = std::max(1, static_cast<int>(defense * getStatStageMultiplier(defenseStage)));
+    
+    // Calculate base damage
+    int baseDamage = ((2 * attacker.level) / 5 + 2) * moves.getPower(move) * attack / defense / 50 + 2;
+    
+    // STAB (Same Type Attack Bonus)
+    float stab = 1.0f;
+    if (moveType == attacker.getPrimaryType() || moveType == attacker.getSecondaryType()) {
+        stab = 1.5f;
+    }
+    
+    // Environment boost
+    float environmentBoost = 1.0f;
+    if (moveType == environment.getBoostedType()) {
+        environmentBoost = environment.getBoostMultiplier();
+    }
+    
+    float criticalBoost = critical ? CRITICAL_HIT_MULTIPLIER : 1.0f;
+    float randomFactor = rollPercent / 100.0f;
+    
+    // Final damage calculation
+    int finalDamage = static_cast<int>(baseDamage * stab * typeEffectiveness * environmentBoost *
+                                       criticalBoost * randomFactor * difficulty);
+    
+    return std::max(1, finalDamage);  // Always do at least 1 damage
+}
+
+// Calculate the chance a move connects
+float computeHitChance(const Pokemon& attacker, const Pokemon& defender, MoveId move) {
+    int accuracyStage = attacker.getStatStage(Stat::ACCURACY) - defender.getStatStage(Stat::EVASION);
+    float hitChance = moveRegistry().getAccuracy(move) / 100.0f * getAccuracyStageMultiplier(accuracyStage);
+    return std::min(1.0f, std::max(0.0f, hitChance));
+}
+
+// Enumerate the exact outcome distribution of a move
+DamageDistribution computeDamageDistribution(const Pokemon& attacker, const Pokemon& defender, MoveId move,
+                                             const Environment& environment, float difficulty) {
+    const MoveRegistry& moves = moveRegistry();
+    DamageDistribution result;
+    result.hitChance = computeHitChance(attacker, defender, move);
+    
+    bool damaging = moves.getCategory(move) != MoveCategory::STATUS;
+    bool immune = damaging && defender.getTypeEffectiveness(moves.getType(move)) == 0.0f;
+    result.critChance = (damaging && !immune) ? CRITICAL_HIT_CHANCE : 0.0;
+    
+    // Status only lands on a hit, on a defender without a status, and not through an immunity
+    if (moves.hasStatusEffect(move) && !immune && defender.status == StatusEffect::NONE) {
+        result.statusChance = result.hitChance * moves.getStatusChance(move) / 100.0;
+    }
+    
+    // Every roll is equally likely; each one may or may not crit
+    int maxDamage = 0;
+    int minDamage = std::numeric_limits<int>::max();
+    int damages[2][DAMAGE_ROLL_COUNT];
+    for (int crit = 0; crit < 2; ++crit) {
+        for (int roll = 0; roll < DAMAGE_ROLL_COUNT; ++roll) {
+            int damage = computeDamage(attacker, defender, move, environment, difficulty,
+                                       DAMAGE_ROLL_MIN + roll, crit == 1);
+            damages[crit][roll] = damage;
+            maxDamage = std::max(maxDamage, damage);
+            minDamage = std::min(minDamage, damage);
+        }
+    }
+    result.minDamage = minDamage;
+    result.maxDamage = maxDamage;
+    
+    result.probabilities.assign(maxDamage + 1, 0.0);
+    result.probabilities[0] += 1.0 - result.hitChance;
+    for (int crit = 0; crit < 2; ++crit) {
+        double critWeight = crit ? result.critChance : 1.0 - result.critChance;
+        double weight = result.hitChance * critWeight / DAMAGE_ROLL_COUNT;
+        for (int roll = 0; roll < DAMAGE_ROLL_COUNT; ++roll) {
+            result.probabilities[damages[crit][roll]] += weight;
+        }
+    }
+    
+    for (int damage = 1; damage <= maxDamage; ++damage) {
+        result.expectedDamage += damage * result.probabilities[damage];
+        if (damage >= defender.hp) {
+            result.koProbability += result.probabilities[damage];
+        }
+    }
+    
+    // Expected uses to KO: track the distribution of the defender's remaining HP use by use
+    int hp = std::max(0, defender.hp);
+    if (hp == 0) {
+        result.koProbability = 1.0;
+        return result;
+    }
+    if (maxDamage == 0 || result.probabilities[0] >= 1.0) {
+        result.expectedHitsToKo = std::numeric_limits<double>::infinity();
+        return result;
+    }
+    
+    // Uses that deal no damage only delay the KO: each damaging use takes 1 / (1 - p0) uses on
+    // average, so the expected uses are the expected damaging uses scaled by that factor. Every
+    // damaging use takes at least 1 HP, so tracking at most hp of them is exact; nothing is truncated.
+    double damagingChance = 1.0 - result.probabilities[0];
+    std::vector<std::pair<int, double>> outcomes;
+    for (int damage = 1; damage <= maxDamage; ++damage) {
+        if (result.probabilities[damage] > 0.0) {
+            outcomes.emplace_back(damage, result.probabilities[damage] / damagingChance);
+        }
+    }
+    
+    std::vector<double> remaining(hp + 1, 0.0);
+    std::vector<double> next(hp + 1, 0.0);
+    remaining[hp] = 1.0;
+    double survival = 1.0;
+    double damagingUses = 0.0;
+    for (int use = 0; use < hp && survival > 0.0; ++use) {
+        damagingUses += survival;  // P(still standing before this damaging use)
+        std::fill(next.begin(), next.end(), 0.0);
+        next[0] = remaining[0];
+        for (int h = 1; h <= hp; ++h) {
+            if (remaining[h] == 0.0) {
+                continue;
+            }
+            for (const auto& outcome : outcomes) {
+                next[std::max(0, h - outcome.first)] += remaining[h] * outcome.second;
+            }
+        }
+        remaining.swap(next);
+        survival = std::accumulate(remaining.begin() + 1, remaining.end(), 0.0);
+    }
+    double expected = damagingUses / damagingChance;
+    result.expectedHitsToKo = expected;
+    
+    return result;
+}
+
+// Score every move of an attacker against a batch of defenders
+void computeDamageMatrix(const Pokemon& attacker, const DefenderBatch& defenders,
+                         const Environment& environment, float difficulty, DamageMatrix& result) {
+    const MoveRegistry& moves = moveRegistry();
+    int levelFactor = (2 * attacker.level) / 5 + 2;
+    int attack = static_cast<int>(attacker.attack * getStatStageMultiplier(attacker.getStatStage(Stat::ATTACK)));
+    int specialAttack = static_cast<int>(attacker.specialAttack *
+                                         getStatStageMultiplier(attacker.getStatStage(Stat::SPECIAL_ATTACK)));
+
+    // Accuracy against evasion depends only on the pairing, not on the move
+    alignas(16) float accuracyMultipliers[DAMAGE_MATRIX_TARGETS] = {};
+    int accuracyStage = attacker.getStatStage(Stat::ACCURACY);
+    for (int column = 0; column < defenders.count; ++column) {
+        accuracyMultipliers[column] = getAccuracyStageMultiplier(accuracyStage - defenders.evasionStage[column]);
+    }
+
+    int moveCount = attacker.getMoveCount();
+    for (int m = 0; m < Pokemon::MAX_MOVES; ++m) {
+        if (m >= moveCount) {
+            std::fill(result.hitChance[m], result.hitChance[m] + DAMAGE_MATRIX_TARGETS, 0.0f);
+            std::fill(result.expectedDamage[m], result.expectedDamage[m] + DAMAGE_MATRIX_TARGETS, 0.0f);
+            continue;
+        }
+        MoveId move = attacker.getMove(m);
+        MoveCategory category = moves.getCategory(move);
+        PokemonType moveType = moves.getType(move);
+        bool physical = category == MoveCategory::PHYSICAL;
+
+        MoveRow row;
+        row.numerator = static_cast<double>(levelFactor) * moves.getPower(move) * (physical ? attack : specialAttack);
+        row.defense = physical ? defenders.defense : defenders.specialDefense;
+        bool sameType = moveType == attacker.getPrimaryType() || moveType == attacker.getSecondaryType();
+        row.stab = sameType ? 1.5f : 1.0f;
+        row.environmentBoost = moveType == environment.getBoostedType() ? environment.getBoostMultiplier() : 1.0f;
+        row.accuracy = moves.getAccuracy(move) / 100.0f;
+        for (int column = 0; column < DAMAGE_MATRIX_TARGETS; ++column) {
+            const DefensiveProfile* profile = defenders.profiles[column];
+            bool damaging = profile && category != MoveCategory::STATUS;
+            row.effectiveness[column] = damaging ? profile->multipliers[static_cast<int>(moveType)] : 0.0f;
+        }
+        scoreRow(row, accuracyMultipliers, difficulty, result.hitChance[m], result.expectedDamage[m]);
+    }
+}
\ No newline at end of file
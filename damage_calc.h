@@ -0,0 +1,125 @@
+#ifndef DAMAGE_CALC_H
+#define DAMAGE_CALC_H
+
+#include <vector>
+#include <cstdint>
+#include "pokemon.h"
+#include "move_registry.h"
+#include "environment.h"
+
+/**
+ * @brief Random damage rolls: damage is scaled by one of 85%..100% with equal chance
+ */
+constexpr int DAMAGE_ROLL_MIN = 85;
+constexpr int DAMAGE_ROLL_MAX = 100;
+constexpr int DAMAGE_ROLL_COUNT = DAMAGE_ROLL_MAX - DAMAGE_ROLL_MIN + 1;
+
+/**
+ * @brief Critical hit chance and multiplier
+ */
+constexpr float CRITICAL_HIT_CHANCE = 0.0625f;
+constexpr float CRITICAL_HIT_MULTIPLIER = 1.5f;
+
+/**
+ * @brief Exact outcome distribution of using a move once
+ */
+struct DamageDistribution {
+    std::vector<double> probabilities;  // probabilities[d] = chance of dealing exactly d damage (misses count as 0)
+    double hitChance = 0.0;             // Chance the move connects
+    double critChance = 0.0;            // Chance of a critical hit (given a hit)
+    double statusChance = 0.0;          // Chance the move's status effect lands on the defender
+    double expectedDamage = 0.0;
+    int minDamage = 0;                  // Lowest damage of a hit
+    int maxDamage = 0;                  // Highest damage of a hit
+    double koProbability = 0.0;         // Chance a single use knocks out the defender from its current HP
+    double expectedHitsToKo = 0.0;      // Expected number of uses to knock out the defender, exactly (infinity if it never can)
+};
+
+/**
+ * @brief Columns of a damage matrix: one per opposing team member, padded to whole SIMD vectors
+ */
+constexpr int DAMAGE_MATRIX_TARGETS = 8;
+
+/**
+ * @brief Up to six defenders in struct-of-arrays form, the input of computeDamageMatrix
+ *
+ * Defense stages are applied when a defender is added, so the kernel reads
+ * final stats. Unused columns are immune to everything and score 0.
+ */
+struct DefenderBatch {
+    int count = 0;
+    alignas(16) double defense[DAMAGE_MATRIX_TARGETS];          // After stat stages, at least 1
+    alignas(16) double specialDefense[DAMAGE_MATRIX_TARGETS];   // After stat stages, at least 1
+    int8_t evasionStage[DAMAGE_MATRIX_TARGETS];
+    const DefensiveProfile* profiles[DAMAGE_MATRIX_TARGETS];    // nullptr for unused columns
+
+    DefenderBatch();
+
+    /**
+     * @brief Add a defender as the next column
+     * @param defender The defending Pokemon
+     * @return False if every column is taken
+     */
+    bool add(const Pokemon& defender);
+};
+
+/**
+ * @brief Outcome of every attacker move against every defender of a batch
+ */
+struct DamageMatrix {
+    alignas(16) float hitChance[Pokemon::MAX_MOVES][DAMAGE_MATRIX_TARGETS];
+    alignas(16) float expectedDamage[Pokemon::MAX_MOVES][DAMAGE_MATRIX_TARGETS];  // One use, misses and critical hits included
+};
+
+/**
+ * @brief Calculates the damage of one hit for a fixed roll
+ * @param attacker The attacking Pokemon
+ * @param defender The defending Pokemon
+ * @param move ID of the move used
+ * @param environment The battle environment
+ * @param difficulty The battle's difficulty multiplier
+ * @param rollPercent The random roll (DAMAGE_ROLL_MIN..DAMAGE_ROLL_MAX)
+ * @param critical Whether the hit is a critical hit
+ * @return The damage dealt (0 for status moves and immune defenders)
+ */
+int computeDamage(const Pokemon& attacker, const Pokemon& defender, MoveId move,
+                  const Environment& environment, float difficulty, int rollPercent, bool critical);
+
+/**
+ * @brief Calculates the chance a move connects, including accuracy and evasion stages
+ * @param attacker The attacking Pokemon
+ * @param defender The defending Pokemon
+ * @param move ID of the move used
+ * @return Hit chance between 0 and 1
+ */
+float computeHitChance(const Pokemon& attacker, const Pokemon& defender, MoveId move);
+
+/**
+ * @brief Enumerates every roll, critical hit and miss of a move exactly
+ * @param attacker The attacking Pokemon
+ * @param defender The defending Pokemon
+ * @param move ID of the move used
+ * @param environment The battle environment
+ * @param difficulty The battle's difficulty multiplier
+ * @return The exact damage distribution and KO statistics
+ */
+DamageDistribution computeDamageDistribution(const Pokemon& attacker, const Pokemon& defender, MoveId move,
+                                             const Environment& environment, float difficulty);
+
+/**
+ * @brief Scores every move of an attacker against a whole batch of defenders at once
+ *
+ * Gives the same hit chances and expected damage as computeHitChance and
+ * computeDamageDistribution, rounded to float, with every roll truncated
+ * exactly like computeDamage. Uses SSE2 where available, with a scalar
+ * fallback. Rows past the attacker's last move are 0.
+ * @param attacker The attacking Pokemon
+ * @param defenders The defenders, one per column
+ * @param environment The battle environment
+ * @param difficulty The battle's difficulty multiplier
+ * @param result Receives one row per move and one column per defender
+ */
+void computeDamageMatrix(const Pokemon& attacker, const DefenderBatch& defenders,
+                         const Environment& environment, float difficulty, DamageMatrix& result);
+
+#endif // DAMAGE_CALC_H
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "data_generation.h"
+#include "data_loader.h"
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+
+namespace {
+
+// Refuse every later change to a generation's registries
+void seal(DataGeneration& generation) {
+    generation.moves.seal();
+    generation.species.seal();
+    generation.itemDefinitions.seal();
+}
+
+// The published generation
+struct GenerationStore {
+    std::shared_ptr<DataGeneration> current;        // Read and written with std::atomic_load/atomic_store
+    std::mutex publishMutex;
+
+    // The empty generation current at startup counts as published too
+    GenerationStore() : current(std::make_shared<DataGeneration>()) {
+        seal(*current);
+    }
+};
+
+GenerationStore& generationStore() {
+    static GenerationStore store;
+    return store;
+}
+
+// FNV-1a over some bytes, continuing from a previous hash
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Hash a name followed by some whole numbers
+uint64_t hashEntry(const std::string& name, std::initializer_list<int64_t> values) {
+    uint64_t hash = fnv1a(name.data(), name.size(), 0xCBF29CE484222325ULL);
+    for (int64_t value : values) {
+        hash = fnv1a(&value, sizeof(value), hash);
+    }
+    return hash;
+}
+
+// What the calling thread reads: its innermost pin, or else the generation it holds for unpinned reads
+thread_local std::shared_ptr<DataGeneration> pinnedGeneration;
+thread_local std::shared_ptr<DataGeneration> unpinnedGeneration;
+thread_local DataGeneration* activeRaw = nullptr;   // Whichever of the two is read (nullptr: not chosen yet)
+
+} // namespace
+
+// Load a new generation from the data files
+std::shared_ptr<DataGeneration> DataGeneration::load(const DataFiles& files, const DataGeneration* previous) {
+    std::shared_ptr<DataGeneration> next = previous ? std::make_shared<DataGeneration>(*previous)
+                                                    : std::make_shared<DataGeneration>();
+    
+    // The loaders register into whatever generation the thread reads, so point it at the new one
+    GenerationPin pin(next);
+    next->moves.loadFromFile(files.moves);
+    next->pokemon = DataLoader::loadPokemon(files.pokemon);
+    next->items = DataLoader::loadItems(files.items);
+    for (const Item& item : next->items) {
+        next->itemDefinitions.add(item);
+    }
+    return next;
+}
+
+// Hash every move and species; entries are summed so registration order doesn't matter
+uint64_t DataGeneration::hash() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        MoveId id = static_cast<MoveId>(i);
+        total += hashEntry(moves.getName(id), {static_cast<int64_t>(moves.getType(id)),
+                                               static_cast<int64_t>(moves.getCategory(id)),
+                                               moves.getPower(id), moves.getAccuracy(id), moves.getPp(id),
+                                               static_cast<int64_t>(moves.getStatusEffect(id)),
+                                               moves.getStatusChance(id)});
+    }
+    for (size_t i = 0; i < species.size(); ++i) {
+        const Species& entry = species.get(static_cast<SpeciesId>(i));
+        std::string evolution = entry.canEvolve() ? species.get(entry.evolution).name : std::string();
+        total += hashEntry(entry.name, {entry.baseHp, entry.baseAttack, entry.baseDefense, entry.baseSpecialAttack,
+                                        entry.baseSpecialDefense, entry.baseSpeed,
+                                        static_cast<int64_t>(entry.primaryType),
+                                        static_cast<int64_t>(entry.secondaryType), entry.evolutionLevel}) ^
+                 hashEntry(evolution, {});
+    }
+    return total;
+}
+
+// Get the current generation
+std::shared_ptr<DataGeneration> DataGeneration::current() {
+    return std::atomic_load(&generationStore().current);
+}
+
+// Make a generation current
+void DataGeneration::publish(std::shared_ptr<DataGeneration> next) {
+    GenerationStore& store = generationStore();
+    {
+        std::lock_guard<std::mutex> lock(store.publishMutex);
+        next->number = std::atomic_load(&store.current)->number + 1;
+        seal(*next);
+        
+        // The old generation goes when its last pin or unpinned reader lets go of it
+        std::atomic_store(&store.current, std::move(next));
+    }
+    refresh();
+}
+
+// Let the calling thread's unpinned reads move on to the current generation
+void DataGeneration::refresh() {
+    unpinnedGeneration.reset();
+    if (!pinnedGeneration) {
+        activeRaw = nullptr;
+    }
+}
+
+// Get the generation the calling thread reads
+DataGeneration& DataGeneration::active() {
+    if (!activeRaw) {
+        unpinnedGeneration = current();
+        activeRaw = unpinnedGeneration.get();
+    }
+    return *activeRaw;
+}
+
+// Get a shared handle to the generation the calling thread reads
+std::shared_ptr<DataGeneration> DataGeneration::activeHandle() {
+    if (pinnedGeneration) {
+        return pinnedGeneration;
+    }
+    active();
+    return unpinnedGeneration;
+}
+
+// Pin a generation to the calling thread
+GenerationPin::GenerationPin(std::shared_ptr<DataGeneration> pinned)
+    : generation(std::move(pinned)), previous(pinnedGeneration) {
+    pinnedGeneration = generation;
+    activeRaw = generation.get();
+}
+
+// Restore the thread's previous pin
+GenerationPin::~GenerationPin() {
+    pinnedGeneration = previous;
+    activeRaw = previous ? previous.get() : unpinnedGeneration.get();
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef DATA_GENERATION_H
+#define DATA_GENERATION_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "move_registry.h"
+#include "item_registry.h"
+#include "species.h"
+#include "pokemon.h"
+#include "item.h"
+
+/**
+ * @brief Data files a generation is loaded from
+ */
+struct DataFiles {
+    std::string pokemon = "pokemon.csv";
+    std::string moves = "moves.csv";
+    std::string items = "items.csv";
+};
+
+/**
+ * @brief One immutable version of the game data, swapped in with read-copy-update
+ *
+ * The current generation is replaced atomically when the data files are
+ * reloaded. Publishing a generation seals its registries, so it never changes
+ * afterwards; new data always goes into a new generation. Readers hold
+ * generations through shared_ptr, so an old generation is freed when its last
+ * reader lets go of it, never while one still reads it.
+ *
+ * A battle pins the generation it started with (see GenerationPin), so it
+ * finishes on the old tables while new battles pick up the new ones.
+ * MoveRegistry::instance(), SpeciesRegistry::instance() and
+ * ItemRegistry::instance() resolve to the calling thread's pinned
+ * generation. A thread without a pin holds on to the generation that was
+ * current at its first read, until it calls refresh() or publishes. A reload
+ * starts from a copy of the current generation, so every move, species and
+ * item keeps its ID.
+ */
+struct DataGeneration {
+    uint64_t number = 0;
+    MoveRegistry moves;
+    SpeciesRegistry species;
+    std::vector<Pokemon> pokemon;       // One Pokemon of each species in the files
+    std::vector<Item> items;
+    ItemRegistry itemDefinitions;       // Every item an inventory refers to, by ItemId
+
+    /**
+     * @brief Hash the generation's moves and species, to tell whether two sets of data play the same
+     * @return Hash of every move and species (independent of the order they were registered in)
+     */
+    uint64_t hash() const;
+
+    /**
+     * @brief Load a new generation from the data files
+     * @param files The files to load
+     * @param previous Generation whose IDs are carried over (nullptr for none)
+     * @return The new, not yet published generation
+     * @throws CsvParseError or std::runtime_error if a file can't be loaded
+     */
+    static std::shared_ptr<DataGeneration> load(const DataFiles& files, const DataGeneration* previous);
+
+    /**
+     * @brief Get the current generation
+     * @return The newest published generation
+     */
+    static std::shared_ptr<DataGeneration> current();
+
+    /**
+     * @brief Seal a generation and make it current; battles that pinned an older one keep it
+     *
+     * Also refreshes the calling thread, so its unpinned reads see the new generation.
+     * @param next The generation to publish (its number is assigned here)
+     */
+    static void publish(std::shared_ptr<DataGeneration> next);
+
+    /**
+     * @brief Let the calling thread's unpinned reads move on to the current generation
+     *
+     * References the thread got from unpinned reads before the call may be
+     * freed, so only call it where the thread holds none.
+     */
+    static void refresh();
+
+    /**
+     * @brief Get the generation the calling thread reads
+     * @return The pinned generation, or the one the thread holds for unpinned reads
+     */
+    static DataGeneration& active();
+
+    /**
+     * @brief Get a shared handle to the generation the calling thread reads
+     * @return The generation active() returns (for pinning helper threads)
+     */
+    static std::shared_ptr<DataGeneration> activeHandle();
+};
+
+/**
+ * @brief Pins a data generation to the calling thread for the pin's lifetime
+ */
+class GenerationPin {
+public:
+    /**
+     * @brief Pin a generation
+     * @param pinned The generation to read (defaults to the current one)
+     */
+    explicit GenerationPin(std::shared_ptr<DataGeneration> pinned = DataGeneration::current());
+    ~GenerationPin();
+
+    GenerationPin(const GenerationPin&) = delete;
+    GenerationPin& operator=(const GenerationPin&) = delete;
+
+    /**
+     * @brief Get the pinned generation
+     * @return The generation
+     */
+    const DataGeneration& get() const { return *generation; }
+
+private:
+    std::shared_ptr<DataGeneration> generation;
+    std::shared_ptr<DataGeneration> previous;
+};
+
+#endif // DATA_GENERATION_H
\ No newline at end of file
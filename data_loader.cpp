@@ -1,53 +1,184 @@
 #include "data_loader.h"
-#include <fstream>
-#include <sstream>
-#include <iostream>
+#include "metrics.h"
+#include <array>
+#include <unordered_map>
+
+namespace {
+
+// Parse a type field, pointing at it if it isn't a type
+PokemonType parseType(const CsvRow& row, size_t index) {
+    std::string name = row.text(index);
+    PokemonType type = stringToType(name);
+    if (type == PokemonType::NONE && name != "None") {
+        row.fail(index, "unknown type \"" + name + "\"");
+    }
+    return type;
+}
+
+// Parse a move category field
+MoveCategory parseCategory(const CsvRow& row, size_t index) {
+    std::string name = row.text(index);
+    MoveCategory category = stringToCategory(name);
+    if (category == MoveCategory::STATUS && name != "Status") {
+        row.fail(index, "unknown move category \"" + name + "\"");
+    }
+    return category;
+}
+
+// Parse a status effect field
+StatusEffect parseStatus(const CsvRow& row, size_t index) {
+    std::string name = row.text(index);
+    StatusEffect status = stringToStatus(name);
+    if (status == StatusEffect::NONE && name != "None") {
+        row.fail(index, "unknown status effect \"" + name + "\"");
+    }
+    return status;
+}
+
+// Parse an item type field
+ItemType parseItemType(const CsvRow& row, size_t index) {
+    static const std::unordered_map<std::string_view, ItemType> typeMap = {
+        {"POTION", ItemType::POTION},
+        {"STATUS_HEAL", ItemType::STATUS_HEAL},
+        {"STAT_BOOST", ItemType::STAT_BOOST},
+        {"REVIVE", ItemType::REVIVE}
+    };
+    
+    auto it = typeMap.find(row.field(index));
+    if (it == typeMap.end()) {
+        row.fail(index, "unknown item type \"" + row.text(index) + "\"");
+    }
+    return it->second;
+}
+
+} // namespace
 
 std::vector<Pokemon> DataLoader::loadPokemon(const std::string& filename) {
+    ScopedTimer timer(Metric::LOAD_POKEMON);
+    MappedFile file(filename);
+    std::vector<PokemonRow> rows = parseCsv<PokemonRow>(file.data(), filename, parsePokemonLine);
+    
+    // Species are registered in file order so their IDs don't depend on the thread count
+    SpeciesRegistry& registry = SpeciesRegistry::instance();
     std::vector<Pokemon> pokemonList;
-    std::ifstream file(filename);
-    std::string line;
+    pokemonList.reserve(rows.size());
+    std::vector<SpeciesId> ids(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        ids[i] = registry.set(rows[i].species);
+        pokemonList.emplace_back(ids[i]);
+    }
 
-    while (std::getline(file, line)) {
-        pokemonList.push_back(parsePokemonLine(line));
+    // Evolutions may name species further down the file, so they are linked last
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i].evolutionForm.empty()) {
+            continue;
+        }
+        SpeciesId target = registry.find(rows[i].evolutionForm);
+        if (target != INVALID_SPECIES_ID) {
+            registry.setEvolution(ids[i], target, rows[i].species.evolutionLevel);
+        }
     }
+
+    // The file has no move column, so every Pokemon starts with the default moves
+    addDefaultMoves(pokemonList);
     return pokemonList;
 }
 
-std::vector<Move> DataLoader::loadMoves(const std::string& filename) {
-    std::vector<Move> moveList;
-    std::ifstream file(filename);
-    std::string line;
+// Teach every Pokemon Tackle and the first damaging move of each of its types
+void DataLoader::addDefaultMoves(std::vector<Pokemon>& pokemonList) {
+    MoveRegistry& moves = MoveRegistry::instance();
+    MoveId tackle = moves.add(Move("Tackle", PokemonType::NORMAL, MoveCategory::PHYSICAL, 40, 100, 35,
+                                   StatusEffect::NONE, 0));
+
+    // Moves are searched in registry order, which is file order (ID 0 is the confusion self-hit)
+    std::array<MoveId, TYPE_COUNT> typeMoves;
+    typeMoves.fill(INVALID_MOVE_ID);
+    for (size_t id = 1; id < moves.size(); ++id) {
+        MoveId move = static_cast<MoveId>(id);
+        int type = static_cast<int>(moves.getType(move));
+        if (typeMoves[type] == INVALID_MOVE_ID && moves.getCategory(move) != MoveCategory::STATUS &&
+            moves.getPower(move) > 0) {
+            typeMoves[type] = move;
+        }
+    }
 
-    while (std::getline(file, line)) {
-        moveList.push_back(parseMoveLine(line));
+    for (Pokemon& pokemon : pokemonList) {
+        pokemon.addMove(tackle);
+        for (PokemonType type : {pokemon.getPrimaryType(), pokemon.getSecondaryType()}) {
+            MoveId move = typeMoves[static_cast<int>(type)];
+            if (type != PokemonType::NONE && move != INVALID_MOVE_ID && move != tackle) {
+                pokemon.addMove(move);
+            }
+        }
     }
-    return moveList;
 }
 
-std::vector<Item> DataLoader::loadItems(const std::string& filename) {
-    std::vector<Item> itemList;
-    std::ifstream file(filename);
-    std::string line;
+std::vector<Move> DataLoader::loadMoves(const std::string& filename) {
+    ScopedTimer timer(Metric::LOAD_MOVES);
+    MappedFile file(filename);
+    return parseCsv<Move>(file.data(), filename, parseMoveLine);
+}
 
-    while (std::getline(file, line)) {
-        itemList.push_back(parseItemLine(line));
-    }
-    return itemList;
+std::vector<Item> DataLoader::loadItems(const std::string& filename) {
+    ScopedTimer timer(Metric::LOAD_ITEMS);
+    MappedFile file(filename);
+    return parseCsv<Item>(file.data(), filename, parseItemLine);
 }
 
 void DataLoader::saveDefaultFiles() {
     // Implementation for saving default files if they don't exist
 }
 
-Pokemon DataLoader::parsePokemonLine(const std::string& line) {
-    // Implementation for parsing a Pokemon line
+DataLoader::PokemonRow DataLoader::parsePokemonLine(const CsvRow& row) {
+    // Name,HP,Attack,Defense,SpecialAttack,SpecialDefense,Speed,PrimaryType,SecondaryType,EvolutionForm,EvolutionLevel
+    row.expectFields(8, 11);
+    
+    PokemonRow result;
+    Species& species = result.species;
+    species.name = row.text(0);
+    species.baseHp = row.integer(1);
+    species.baseAttack = row.integer(2);
+    species.baseDefense = row.integer(3);
+    species.baseSpecialAttack = row.integer(4);
+    species.baseSpecialDefense = row.integer(5);
+    species.baseSpeed = row.integer(6);
+    species.primaryType = parseType(row, 7);
+    species.secondaryType = row.field(8).empty() ? PokemonType::NONE : parseType(row, 8);
+    result.evolutionForm = row.text(9);
+    species.evolutionLevel = row.integer(10, 0);
+    return result;
 }
 
-Move DataLoader::parseMoveLine(const std::string& line) {
-    // Implementation for parsing a Move line
+Move DataLoader::parseMoveLine(const CsvRow& row) {
+    // Name,Type,Category,Power,Accuracy,PP,StatusEffect,StatusChance
+    row.expectFields(8, 8);
+    
+    return Move(row.text(0), parseType(row, 1), parseCategory(row, 2), row.integer(3),
+                row.integer(4), row.integer(5), parseStatus(row, 6), row.integer(7));
 }
 
-Item DataLoader::parseItemLine(const std::string& line) {
-    // Implementation for parsing an Item line
+Item DataLoader::parseItemLine(const CsvRow& row) {
+    // Name,Type,Value (STAT_BOOST: Name,Type,Stat,Amount)
+    row.expectFields(3, 4);
+    
+    std::string name = row.text(0);
+    switch (parseItemType(row, 1)) {
+        case ItemType::POTION:
+            return Item(name, row.integer(2));
+        case ItemType::STATUS_HEAL:
+            return Item(name, parseStatus(row, 2));
+        case ItemType::STAT_BOOST: {
+            std::string statName = row.text(2);
+            if (stringToStat(statName) == Stat::NONE) {
+                row.fail(2, "unknown stat \"" + statName + "\"");
+            }
+            return Item(name, statName, row.integer(3));
+        }
+        case ItemType::REVIVE:
+        default: {
+            Item item(name, 0);
+            item.type = ItemType::REVIVE;
+            return item;
+        }
+    }
 }
\ No newline at end of file
@@ -4,18 +4,24 @@
 #include <vector>
 #include <string>
 #include "pokemon.h"
+#include "species.h"
 #include "move.h"
 #include "item.h"
+#include "csv_reader.h"
 
 /**
  * @brief Class for loading Pokemon, moves, and items from data files
+ *
+ * Files are memory mapped and split into string_view fields without copying;
+ * big files are parsed in chunks on several threads. Malformed lines throw a
+ * CsvParseError naming the file, line and column.
  */
 class DataLoader {
 public:
     /**
-     * @brief Load Pokemon data from file
+     * @brief Load Pokemon data from file, registering every species
      * @param filename The file to load from
-     * @return Vector of Pokemon objects
+     * @return One Pokemon of each species in the file, knowing the default moves
      */
     static std::vector<Pokemon> loadPokemon(const std::string& filename);
     
@@ -33,32 +39,46 @@ public:
      */
     static std::vector<Item> loadItems(const std::string& filename);
     
+    /**
+     * @brief Teach Pokemon loaded without moves Tackle and a move of each of their types
+     * @param pokemonList The Pokemon to teach (the moves must already be registered)
+     */
+    static void addDefaultMoves(std::vector<Pokemon>& pokemonList);
+    
     /**
      * @brief Save default data files if they don't exist
      */
     static void saveDefaultFiles();
 
 private:
+    /**
+     * @brief A parsed line of Pokemon data
+     */
+    struct PokemonRow {
+        Species species;
+        std::string evolutionForm;  // Name of the species it evolves into (empty if none)
+    };
+    
     /**
      * @brief Parse a line of Pokemon data
-     * @param line The line to parse
-     * @return Pokemon object
+     * @param row The line's fields
+     * @return Species record and evolution name (the evolution is linked once every species is known)
      */
-    static Pokemon parsePokemonLine(const std::string& line);
+    static PokemonRow parsePokemonLine(const CsvRow& row);
     
     /**
      * @brief Parse a line of move data
-     * @param line The line to parse
+     * @param row The line's fields
      * @return Move object
      */
-    static Move parseMoveLine(const std::string& line);
+    static Move parseMoveLine(const CsvRow& row);
     
     /**
      * @brief Parse a line of item data
-     * @param line The line to parse
+     * @param row The line's fields
      * @return Item object
      */
-    static Item parseItemLine(const std::string& line);
+    static Item parseItemLine(const CsvRow& row);
 };
 
 #endif // DATA_LOADER_H
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "data_watcher.h"
+#include <iostream>
+#include <exception>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+
+// Time to wait after a change before reloading, so an editor's burst of writes is loaded once
+constexpr int DEBOUNCE_MS = 100;
+
+// How often the watcher checks if it should stop
+constexpr int POLL_MS = 250;
+
+// Get the directory part of a path
+std::string directoryOf(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    if (slash == std::string::npos) {
+        return ".";
+    }
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+// Get the file name part of a path
+std::string fileNameOf(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+#endif
+
+// Constructor
+DataWatcher::DataWatcher(const DataFiles& watchedFiles)
+    : files(watchedFiles), inotifyFd(-1), watching(false), stopping(false) {
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        std::cerr << "Can't watch the data files; changes won't be reloaded" << std::endl;
+        return;
+    }
+    
+    // Watch the directories, since editors often replace a file instead of writing to it
+    for (const std::string* path : {&files.pokemon, &files.moves, &files.items}) {
+        if (inotify_add_watch(inotifyFd, directoryOf(*path).c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) >= 0) {
+            watching = true;
+        }
+    }
+    if (!watching) {
+        close(inotifyFd);
+        inotifyFd = -1;
+        return;
+    }
+    worker = std::thread(&DataWatcher::run, this);
+#endif
+}
+
+// Destructor
+DataWatcher::~DataWatcher() {
+    stopping = true;
+    if (worker.joinable()) {
+        worker.join();
+    }
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+    }
+#endif
+}
+
+// Reload the data files and publish them
+bool DataWatcher::reload() {
+    try {
+        std::shared_ptr<DataGeneration> current = DataGeneration::current();
+        DataGeneration::publish(DataGeneration::load(files, current.get()));
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Data files not reloaded, keeping the current data: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Wait for changes to the data files and reload them
+void DataWatcher::run() {
+#ifdef __linux__
+    std::vector<std::string> names = {fileNameOf(files.pokemon), fileNameOf(files.moves), fileNameOf(files.items)};
+    alignas(inotify_event) char buffer[4096];
+    bool pending = false;
+    auto changedAt = std::chrono::steady_clock::now();
+    
+    while (!stopping) {
+        pollfd descriptor = {inotifyFd, POLLIN, 0};
+        int ready = poll(&descriptor, 1, pending ? DEBOUNCE_MS : POLL_MS);
+        
+        if (ready > 0) {
+            ssize_t length;
+            while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+                for (char* position = buffer; position < buffer + length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(position);
+                    if (event->len > 0) {
+                        for (const std::string& name : names) {
+                            if (name == event->name) {
+                                pending = true;
+                                changedAt = std::chrono::steady_clock::now();
+                            }
+                        }
+                    }
+                    position += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+        
+        if (pending && std::chrono::steady_clock::now() - changedAt >= std::chrono::milliseconds(DEBOUNCE_MS)) {
+            pending = false;
+            reload();
+        }
+    }
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef DATA_WATCHER_H
+#define DATA_WATCHER_H
+
+#include <atomic>
+#include <thread>
+#include "data_generation.h"
+
+/**
+ * @brief Watches the data files and publishes a new DataGeneration when they change
+ *
+ * Uses inotify on Linux and does nothing on other platforms. A file that
+ * fails to load is reported and the current generation is kept.
+ */
+class DataWatcher {
+public:
+    /**
+     * @brief Start watching
+     * @param watchedFiles The data files to watch and reload
+     */
+    explicit DataWatcher(const DataFiles& watchedFiles);
+
+    /**
+     * @brief Stop watching
+     */
+    ~DataWatcher();
+
+    DataWatcher(const DataWatcher&) = delete;
+    DataWatcher& operator=(const DataWatcher&) = delete;
+
+    /**
+     * @brief Check if the files are being watched
+     * @return False if watching isn't supported or couldn't be set up
+     */
+    bool isWatching() const { return watching; }
+
+    /**
+     * @brief Reload the data files and publish them now
+     * @return True if the files loaded
+     */
+    bool reload();
+
+private:
+    DataFiles files;
+    int inotifyFd;
+    bool watching;
+    std::atomic<bool> stopping;
+    std::thread worker;
+
+    void run();
+};
+
+#endif // DATA_WATCHER_H
\ No newline at end of file
@@ -0,0 +1,391 @@
+#include "dex_image.h"
+#include "data_loader.h"
+#include "move_registry.h"
+#include "species.h"
+#include "data_generation.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+constexpr size_t DEX_ALIGNMENT = 8;
+
+// FNV-1a over a block of bytes
+uint64_t fnv1a64(const char* data, size_t size) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Hash of a name in the index; the kind is mixed in so equal names of different kinds spread out
+uint32_t indexHash(DexKind kind, std::string_view name) {
+    uint32_t hash = 0x811C9DC5u ^ (static_cast<uint32_t>(kind) * 0x9E3779B9u);
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+// Clamp a value into a small integer field
+template <typename T>
+T narrow(int value) {
+    return static_cast<T>(std::min<int>(std::max<int>(value, std::numeric_limits<T>::min()),
+                                        std::numeric_limits<T>::max()));
+}
+
+// Builds the sections of an image in memory
+class DexWriter {
+public:
+    // Intern a string in the pool
+    uint32_t addString(const std::string& text) {
+        auto it = offsets.find(text);
+        if (it != offsets.end()) {
+            return it->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(pool.size());
+        pool.insert(pool.end(), text.begin(), text.end());
+        pool.push_back('\0');
+        offsets.emplace(text, offset);
+        return offset;
+    }
+
+    // Add a name to the index
+    void addName(DexKind kind, uint32_t id, const std::string& name) {
+        names.push_back({kind, id, name});
+    }
+
+    // Build the open-addressing index, at most half full
+    std::vector<DexIndexSlot> buildIndex() const {
+        size_t capacity = 1;
+        while (capacity < names.size() * 2 + 1) {
+            capacity *= 2;
+        }
+        std::vector<DexIndexSlot> slots(capacity);
+        for (DexIndexSlot& slot : slots) {
+            slot = DexIndexSlot{0, 0, static_cast<uint16_t>(DexKind::EMPTY), 0};
+        }
+        for (const Name& name : names) {
+            uint32_t hash = indexHash(name.kind, name.text);
+            size_t i = hash & (capacity - 1);
+            while (slots[i].kind != static_cast<uint16_t>(DexKind::EMPTY)) {
+                i = (i + 1) & (capacity - 1);
+            }
+            slots[i] = DexIndexSlot{hash, name.id, static_cast<uint16_t>(name.kind), 0};
+        }
+        return slots;
+    }
+
+    const std::vector<char>& getPool() const { return pool; }
+
+private:
+    struct Name {
+        DexKind kind;
+        uint32_t id;
+        std::string text;
+    };
+
+    std::vector<char> pool;
+    std::unordered_map<std::string, uint32_t> offsets;
+    std::vector<Name> names;
+};
+
+// Append a section to the body of an image
+void appendSection(std::vector<char>& body, DexHeader& header, DexSection which,
+                   const void* data, size_t size, size_t count) {
+    while ((sizeof(DexHeader) + body.size()) % DEX_ALIGNMENT != 0) {
+        body.push_back('\0');
+    }
+    DexSectionInfo& info = header.sections[static_cast<int>(which)];
+    info.offset = sizeof(DexHeader) + body.size();
+    info.size = size;
+    info.count = count;
+    const char* bytes = static_cast<const char*>(data);
+    body.insert(body.end(), bytes, bytes + size);
+}
+
+} // namespace
+
+// Map a dex file and check it
+DexImage::DexImage(const std::string& filename)
+    : file(filename), header(nullptr), speciesRecords(nullptr), speciesTotal(0), moveRecords(nullptr),
+      moveTotal(0), itemRecords(nullptr), itemTotal(0), indexSlots(nullptr), indexSize(0) {
+    std::string_view data = file.data();
+    if (data.size() < sizeof(DexHeader)) {
+        throw std::runtime_error(filename + " is too small to be a dex");
+    }
+    header = reinterpret_cast<const DexHeader*>(data.data());
+    if (std::memcmp(header->magic, DEX_MAGIC, sizeof(DEX_MAGIC)) != 0) {
+        throw std::runtime_error(filename + " is not a dex");
+    }
+    if (header->byteOrderMark != DEX_BYTE_ORDER_MARK) {
+        throw std::runtime_error(filename + " was built on a machine with another byte order");
+    }
+    if (header->version != DEX_VERSION) {
+        throw std::runtime_error(filename + " has dex version " + std::to_string(header->version) +
+                                 ", expected " + std::to_string(DEX_VERSION));
+    }
+    if (header->fileSize != data.size()) {
+        throw std::runtime_error(filename + " is truncated");
+    }
+    if (fnv1a64(data.data() + sizeof(DexHeader), data.size() - sizeof(DexHeader)) != header->checksum) {
+        throw std::runtime_error(filename + " is corrupt (checksum mismatch)");
+    }
+
+    speciesRecords = reinterpret_cast<const DexSpeciesRecord*>(
+        sectionData(DexSection::SPECIES, sizeof(DexSpeciesRecord), speciesTotal));
+    moveRecords = reinterpret_cast<const DexMoveRecord*>(
+        sectionData(DexSection::MOVES, sizeof(DexMoveRecord), moveTotal));
+    itemRecords = reinterpret_cast<const DexItemRecord*>(
+        sectionData(DexSection::ITEMS, sizeof(DexItemRecord), itemTotal));
+    indexSlots = reinterpret_cast<const DexIndexSlot*>(
+        sectionData(DexSection::INDEX, sizeof(DexIndexSlot), indexSize));
+    size_t poolSize = 0;
+    const char* pool = sectionData(DexSection::STRINGS, 1, poolSize);
+    strings = std::string_view(pool, poolSize);
+    if (poolSize == 0 || strings.back() != '\0' || (indexSize & (indexSize - 1)) != 0) {
+        throw std::runtime_error(filename + " is corrupt (bad string pool or index)");
+    }
+
+    // Every reference must stay inside the image
+    auto checkName = [&](uint32_t offset) {
+        if (offset >= poolSize) {
+            throw std::runtime_error(filename + " is corrupt (string offset out of range)");
+        }
+    };
+    // Enum bytes index lookup tables such as the type chart, so they are checked too
+    auto checkEnum = [&](uint8_t value, int last, const char* what) {
+        if (value > last) {
+            throw std::runtime_error(filename + " is corrupt (" + what + " out of range)");
+        }
+    };
+    constexpr int LAST_TYPE = static_cast<int>(PokemonType::NONE);
+    constexpr int LAST_STATUS = static_cast<int>(StatusEffect::CONFUSION);
+    for (size_t i = 0; i < speciesTotal; ++i) {
+        const DexSpeciesRecord& record = speciesRecords[i];
+        checkName(record.name);
+        checkEnum(record.primaryType, LAST_TYPE, "type");
+        checkEnum(record.secondaryType, LAST_TYPE, "type");
+        if (record.evolution != DEX_NO_EVOLUTION && record.evolution >= speciesTotal) {
+            throw std::runtime_error(filename + " is corrupt (evolution out of range)");
+        }
+    }
+    for (size_t i = 0; i < moveTotal; ++i) {
+        const DexMoveRecord& record = moveRecords[i];
+        checkName(record.name);
+        checkEnum(record.type, LAST_TYPE, "type");
+        checkEnum(record.category, static_cast<int>(MoveCategory::STATUS), "move category");
+        checkEnum(record.statusEffect, LAST_STATUS, "status effect");
+    }
+    for (size_t i = 0; i < itemTotal; ++i) {
+        const DexItemRecord& record = itemRecords[i];
+        checkName(record.name);
+        checkEnum(record.type, static_cast<int>(ItemType::REVIVE), "item type");
+        checkEnum(record.healStatus, LAST_STATUS, "status effect");
+        checkEnum(record.boostStat, static_cast<int>(Stat::NONE), "stat");
+    }
+}
+
+// Find a section and check that it fits in the file
+const char* DexImage::sectionData(DexSection which, size_t recordSize, size_t& count) const {
+    const DexSectionInfo& info = header->sections[static_cast<int>(which)];
+    if (info.offset % DEX_ALIGNMENT != 0 || info.offset > header->fileSize ||
+        info.size > header->fileSize - info.offset || info.count * recordSize != info.size) {
+        throw std::runtime_error("dex section " + std::to_string(static_cast<int>(which)) + " is out of bounds");
+    }
+    count = static_cast<size_t>(info.count);
+    return file.data().data() + info.offset;
+}
+
+// Get a string of the pool
+std::string_view DexImage::string(uint32_t offset) const {
+    return std::string_view(strings.data() + offset);
+}
+
+// Look up a record by name
+uint32_t DexImage::find(DexKind kind, std::string_view name) const {
+    if (indexSize == 0) {
+        return DEX_NOT_FOUND;
+    }
+    uint32_t hash = indexHash(kind, name);
+    for (size_t i = hash & (indexSize - 1), probes = 0; probes < indexSize; i = (i + 1) & (indexSize - 1), ++probes) {
+        const DexIndexSlot& slot = indexSlots[i];
+        if (slot.kind == static_cast<uint16_t>(DexKind::EMPTY)) {
+            return DEX_NOT_FOUND;
+        }
+        if (slot.kind != static_cast<uint16_t>(kind) || slot.hash != hash) {
+            continue;
+        }
+        uint32_t nameOffset = DEX_NOT_FOUND;
+        if (kind == DexKind::SPECIES && slot.id < speciesTotal) {
+            nameOffset = speciesRecords[slot.id].name;
+        } else if (kind == DexKind::MOVE && slot.id < moveTotal) {
+            nameOffset = moveRecords[slot.id].name;
+        } else if (kind == DexKind::ITEM && slot.id < itemTotal) {
+            nameOffset = itemRecords[slot.id].name;
+        }
+        if (nameOffset != DEX_NOT_FOUND && string(nameOffset) == name) {
+            return slot.id;
+        }
+    }
+    return DEX_NOT_FOUND;
+}
+
+// Get the checksum stored in the header
+uint64_t DexImage::getChecksum() const {
+    return header->checksum;
+}
+
+// Compile the CSV data files into one dex image
+void compileDex(const std::string& pokemonFile, const std::string& movesFile, const std::string& itemsFile,
+                const std::string& outputFile) {
+    // The files are parsed into a scratch generation; the published one is never changed
+    GenerationPin scratch(std::make_shared<DataGeneration>());
+    std::vector<Pokemon> pokemon = DataLoader::loadPokemon(pokemonFile);
+    std::vector<Move> moves = DataLoader::loadMoves(movesFile);
+    std::vector<Item> items = DataLoader::loadItems(itemsFile);
+    if (pokemon.size() >= DEX_NO_EVOLUTION || moves.size() >= INVALID_MOVE_ID) {
+        throw std::runtime_error("Too many species or moves for a dex");
+    }
+
+    DexWriter writer;
+    writer.addString("");
+
+    // Evolutions are stored as record indices
+    std::unordered_map<SpeciesId, uint16_t> recordOf;
+    for (size_t i = 0; i < pokemon.size(); ++i) {
+        recordOf.emplace(pokemon[i].species, static_cast<uint16_t>(i));
+    }
+    std::vector<DexSpeciesRecord> speciesTable;
+    for (size_t i = 0; i < pokemon.size(); ++i) {
+        const Species& species = pokemon[i].getSpecies();
+        DexSpeciesRecord record{};
+        record.name = writer.addString(species.name);
+        record.baseHp = narrow<int16_t>(species.baseHp);
+        record.baseAttack = narrow<int16_t>(species.baseAttack);
+        record.baseDefense = narrow<int16_t>(species.baseDefense);
+        record.baseSpecialAttack = narrow<int16_t>(species.baseSpecialAttack);
+        record.baseSpecialDefense = narrow<int16_t>(species.baseSpecialDefense);
+        record.baseSpeed = narrow<int16_t>(species.baseSpeed);
+        record.primaryType = static_cast<uint8_t>(species.primaryType);
+        record.secondaryType = static_cast<uint8_t>(species.secondaryType);
+        auto evolution = recordOf.find(species.evolution);
+        record.evolution = species.canEvolve() && evolution != recordOf.end() ? evolution->second : DEX_NO_EVOLUTION;
+        record.evolutionLevel = narrow<uint16_t>(species.evolutionLevel);
+        speciesTable.push_back(record);
+        writer.addName(DexKind::SPECIES, static_cast<uint32_t>(i), species.name);
+    }
+
+    std::vector<DexMoveRecord> moveTable;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const Move& move = moves[i];
+        DexMoveRecord record{};
+        record.name = writer.addString(move.name);
+        record.power = narrow<int16_t>(move.power);
+        record.type = static_cast<uint8_t>(move.type);
+        record.category = static_cast<uint8_t>(move.category);
+        record.accuracy = narrow<uint8_t>(move.accuracy);
+        record.pp = narrow<uint8_t>(move.pp);
+        record.statusEffect = static_cast<uint8_t>(move.statusEffect);
+        record.statusChance = narrow<uint8_t>(move.statusChance);
+        moveTable.push_back(record);
+        writer.addName(DexKind::MOVE, static_cast<uint32_t>(i), move.name);
+    }
+
+    std::vector<DexItemRecord> itemTable;
+    for (size_t i = 0; i < items.size(); ++i) {
+        const Item& item = items[i];
+        DexItemRecord record{};
+        record.name = writer.addString(item.name);
+        record.healAmount = item.healAmount;
+        record.type = static_cast<uint8_t>(item.type);
+        record.healStatus = static_cast<uint8_t>(item.healStatus);
+        record.boostStat = static_cast<uint8_t>(item.boostStat);
+        record.boostAmount = narrow<int8_t>(item.boostAmount);
+        itemTable.push_back(record);
+        writer.addName(DexKind::ITEM, static_cast<uint32_t>(i), item.name);
+    }
+
+    std::vector<DexIndexSlot> index = writer.buildIndex();
+    const std::vector<char>& pool = writer.getPool();
+
+    DexHeader header{};
+    std::memcpy(header.magic, DEX_MAGIC, sizeof(DEX_MAGIC));
+    header.version = DEX_VERSION;
+    header.byteOrderMark = DEX_BYTE_ORDER_MARK;
+    std::vector<char> body;
+    appendSection(body, header, DexSection::SPECIES, speciesTable.data(),
+                  speciesTable.size() * sizeof(DexSpeciesRecord), speciesTable.size());
+    appendSection(body, header, DexSection::MOVES, moveTable.data(),
+                  moveTable.size() * sizeof(DexMoveRecord), moveTable.size());
+    appendSection(body, header, DexSection::ITEMS, itemTable.data(),
+                  itemTable.size() * sizeof(DexItemRecord), itemTable.size());
+    appendSection(body, header, DexSection::STRINGS, pool.data(), pool.size(), pool.size());
+    appendSection(body, header, DexSection::INDEX, index.data(), index.size() * sizeof(DexIndexSlot), index.size());
+    header.fileSize = sizeof(DexHeader) + body.size();
+    header.checksum = fnv1a64(body.data(), body.size());
+
+    std::ofstream output(outputFile, std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(body.data(), static_cast<std::streamsize>(body.size()));
+    if (!output) {
+        throw std::runtime_error("Cannot write " + outputFile);
+    }
+}
+
+// Register every species and move of a dex with the global registries
+void importDex(const DexImage& image, std::vector<Pokemon>& pokemon, std::vector<Item>& items) {
+    MoveRegistry& moves = MoveRegistry::instance();
+    for (size_t i = 0; i < image.moveCount(); ++i) {
+        const DexMoveRecord& record = image.move(i);
+        moves.set(Move(std::string(image.string(record.name)), static_cast<PokemonType>(record.type),
+                       static_cast<MoveCategory>(record.category), record.power, record.accuracy, record.pp,
+                       static_cast<StatusEffect>(record.statusEffect), record.statusChance));
+    }
+
+    SpeciesRegistry& registry = SpeciesRegistry::instance();
+    std::vector<SpeciesId> ids(image.speciesCount());
+    pokemon.clear();
+    pokemon.reserve(image.speciesCount());
+    for (size_t i = 0; i < image.speciesCount(); ++i) {
+        const DexSpeciesRecord& record = image.species(i);
+        Species species;
+        species.name = std::string(image.string(record.name));
+        species.baseHp = record.baseHp;
+        species.baseAttack = record.baseAttack;
+        species.baseDefense = record.baseDefense;
+        species.baseSpecialAttack = record.baseSpecialAttack;
+        species.baseSpecialDefense = record.baseSpecialDefense;
+        species.baseSpeed = record.baseSpeed;
+        species.primaryType = static_cast<PokemonType>(record.primaryType);
+        species.secondaryType = static_cast<PokemonType>(record.secondaryType);
+        ids[i] = registry.set(species);
+        pokemon.emplace_back(ids[i]);
+    }
+    for (size_t i = 0; i < image.speciesCount(); ++i) {
+        const DexSpeciesRecord& record = image.species(i);
+        if (record.evolution != DEX_NO_EVOLUTION) {
+            registry.setEvolution(ids[i], ids[record.evolution], record.evolutionLevel);
+        }
+    }
+    // Like the data files, a dex has no move lists
+    DataLoader::addDefaultMoves(pokemon);
+
+    items.clear();
+    items.reserve(image.itemCount());
+    for (size_t i = 0; i < image.itemCount(); ++i) {
+        const DexItemRecord& record = image.item(i);
+        Item item(std::string(image.string(record.name)), record.healAmount);
+        item.type = static_cast<ItemType>(record.type);
+        item.healStatus = static_cast<StatusEffect>(record.healStatus);
+        item.boostStat = static_cast<Stat>(record.boostStat);
+        item.boostAmount = record.boostAmount;
+        items.push_back(item);
+    }
+}
\ No newline at end of file
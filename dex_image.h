@@ -0,0 +1,213 @@
+#ifndef DEX_IMAGE_H
+#define DEX_IMAGE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#include "csv_reader.h"
+#include "pokemon.h"
+#include "item.h"
+
+/**
+ * @brief Binary dex format
+ *
+ * One file holds every species, move and item. It is made of a header
+ * followed by 8-byte aligned sections: three tables of fixed-size records, a
+ * pool of NUL-terminated strings, and an open-addressing hash index from
+ * names to record IDs. Records refer to strings by their offset in the pool.
+ * Everything is stored in the native byte order; the header's byte order
+ * mark rejects images built on a machine with the other order.
+ */
+constexpr char DEX_MAGIC[8] = {'P', 'K', 'M', 'N', 'D', 'E', 'X', '\0'};
+constexpr uint32_t DEX_VERSION = 1;
+constexpr uint32_t DEX_BYTE_ORDER_MARK = 0x01020304;
+constexpr uint32_t DEX_NOT_FOUND = 0xFFFFFFFF;
+constexpr uint16_t DEX_NO_EVOLUTION = 0xFFFF;
+
+/**
+ * @brief Default file name of a compiled dex
+ */
+constexpr const char* DEX_DEFAULT_FILE = "pokedex.bin";
+
+/**
+ * @brief Sections of a dex image
+ */
+enum class DexSection : uint32_t {
+    SPECIES,
+    MOVES,
+    ITEMS,
+    STRINGS,
+    INDEX,
+    COUNT
+};
+
+/**
+ * @brief Kinds of names in the hash index
+ */
+enum class DexKind : uint16_t {
+    EMPTY,      // Unused index slot
+    SPECIES,
+    MOVE,
+    ITEM
+};
+
+/**
+ * @brief Location of one section
+ */
+struct DexSectionInfo {
+    uint64_t offset;    // From the start of the file
+    uint64_t size;      // In bytes
+    uint64_t count;     // Number of records (bytes for the string pool)
+};
+
+/**
+ * @brief File header
+ */
+struct DexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t fileSize;
+    uint64_t checksum;              // FNV-1a of every byte after the header
+    DexSectionInfo sections[static_cast<int>(DexSection::COUNT)];
+};
+
+/**
+ * @brief One species (evolution is a record index, or DEX_NO_EVOLUTION)
+ */
+struct DexSpeciesRecord {
+    uint32_t name;
+    int16_t baseHp;
+    int16_t baseAttack;
+    int16_t baseDefense;
+    int16_t baseSpecialAttack;
+    int16_t baseSpecialDefense;
+    int16_t baseSpeed;
+    uint8_t primaryType;
+    uint8_t secondaryType;
+    uint16_t evolution;
+    uint16_t evolutionLevel;
+    uint16_t reserved;
+};
+
+/**
+ * @brief One move
+ */
+struct DexMoveRecord {
+    uint32_t name;
+    int16_t power;
+    uint8_t type;
+    uint8_t category;
+    uint8_t accuracy;
+    uint8_t pp;
+    uint8_t statusEffect;
+    uint8_t statusChance;
+};
+
+/**
+ * @brief One item
+ */
+struct DexItemRecord {
+    uint32_t name;
+    int32_t healAmount;
+    uint8_t type;
+    uint8_t healStatus;
+    uint8_t boostStat;
+    int8_t boostAmount;
+};
+
+/**
+ * @brief One slot of the name index
+ */
+struct DexIndexSlot {
+    uint32_t hash;
+    uint32_t id;
+    uint16_t kind;      // DexKind
+    uint16_t reserved;
+};
+
+static_assert(std::is_trivially_copyable<DexHeader>::value && sizeof(DexHeader) % 8 == 0, "dex header layout");
+static_assert(sizeof(DexSpeciesRecord) == 24, "dex species record layout");
+static_assert(sizeof(DexMoveRecord) == 12, "dex move record layout");
+static_assert(sizeof(DexItemRecord) == 12, "dex item record layout");
+static_assert(sizeof(DexIndexSlot) == 12, "dex index slot layout");
+
+/**
+ * @brief A compiled dex, memory mapped and read in place
+ */
+class DexImage {
+public:
+    /**
+     * @brief Map a dex file and check it
+     * @param filename The file to open
+     * @throws std::runtime_error if the file is missing, of another version, truncated or corrupt
+     */
+    explicit DexImage(const std::string& filename);
+
+    // Record counts and lookups by ID (ids must be below the count)
+    size_t speciesCount() const { return speciesTotal; }
+    size_t moveCount() const { return moveTotal; }
+    size_t itemCount() const { return itemTotal; }
+    const DexSpeciesRecord& species(size_t id) const { return speciesRecords[id]; }
+    const DexMoveRecord& move(size_t id) const { return moveRecords[id]; }
+    const DexItemRecord& item(size_t id) const { return itemRecords[id]; }
+
+    /**
+     * @brief Get a string of the pool
+     * @param offset The string's offset
+     * @return View of the string inside the image
+     */
+    std::string_view string(uint32_t offset) const;
+
+    /**
+     * @brief Look up a record by name with the hash index
+     * @param kind Kind of record
+     * @param name The name
+     * @return The record's ID, or DEX_NOT_FOUND
+     */
+    uint32_t find(DexKind kind, std::string_view name) const;
+
+    /**
+     * @brief Get the checksum stored in the header
+     * @return The checksum
+     */
+    uint64_t getChecksum() const;
+
+private:
+    MappedFile file;
+    const DexHeader* header;
+    const DexSpeciesRecord* speciesRecords;
+    size_t speciesTotal;
+    const DexMoveRecord* moveRecords;
+    size_t moveTotal;
+    const DexItemRecord* itemRecords;
+    size_t itemTotal;
+    const DexIndexSlot* indexSlots;
+    size_t indexSize;
+    std::string_view strings;
+
+    const char* sectionData(DexSection which, size_t recordSize, size_t& count) const;
+};
+
+/**
+ * @brief Compile the CSV data files into one dex image
+ * @param pokemonFile Pokemon CSV file
+ * @param movesFile Move CSV file
+ * @param itemsFile Item CSV file
+ * @param outputFile Dex file to write
+ * @throws CsvParseError or std::runtime_error if a file can't be read or written
+ */
+void compileDex(const std::string& pokemonFile, const std::string& movesFile, const std::string& itemsFile,
+                const std::string& outputFile);
+
+/**
+ * @brief Register every species and move of a dex with the global registries
+ * @param image The dex
+ * @param pokemon Receives one Pokemon of each species, knowing the default moves
+ * @param items Receives every item
+ */
+void importDex(const DexImage& image, std::vector<Pokemon>& pokemon, std::vector<Item>& items);
+
+#endif // DEX_IMAGE_H
\ No newline at end of file
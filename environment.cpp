@@ -31,6 +31,11 @@ Environment::Environment(BattleEnvironment type) : envType(type), boostMultiplie
     }
 }
 
+// Get the type of environment
+BattleEnvironment Environment::getType() const {
+    return envType;
+}
+
 // Get the name of the environment
 std::string Environment::getName() const {
     static const std::unordered_map<BattleEnvironment, std::string> names = {
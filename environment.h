@@ -28,6 +28,12 @@ public:
      */
     Environment(BattleEnvironment type);
     
+    /**
+     * @brief Get the type of environment
+     * @return The BattleEnvironment value
+     */
+    BattleEnvironment getType() const;
+    
     /**
      * @brief Get the name of the environment
      * @return String name of the environment
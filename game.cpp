@@ -1,13 +1,18 @@
 #include "game.h"
 #include "battle.h"
 #include "data_loader.h"
+#include "move_registry.h"
+#include "dex_image.h"
 #include <iostream>
+#include <fstream>
 #include <algorithm>
-#include <random>
 #include <chrono>
 #include <thread>
 
-Game::Game() : difficulty(1.0f) {
+Game::Game() : difficulty(1.0f), rng(Rng::randomSeed()), dataGeneration(0) {
+    // Normal difficulty until the player picks one
+    aiBudget.maxDepth = 2;
+    aiBudget.timeLimitMs = 15;
     // Default initialization
     currentEnvironment = BattleEnvironment::NORMAL;
 }
@@ -27,9 +32,33 @@ void Game::start() {
 }
 
 void Game::initializeGame() {
-    // Load data from files
-    loadPokemonData();
-    loadItemData();
+    // The data is loaded into a new generation, which is only published once complete
+    std::shared_ptr<DataGeneration> next = std::make_shared<DataGeneration>(*DataGeneration::current());
+    bool fromDex;
+    {
+        GenerationPin pin(next);
+        
+        // A compiled dex replaces the data files when present
+        fromDex = loadDexData(DEX_DEFAULT_FILE);
+        if (!fromDex) {
+            // Load data from files (moves first, Pokemon refer to them)
+            loadMoveData();
+            loadPokemonData();
+            loadItemData();
+        }
+        next->pokemon = allPokemon;
+        next->items = allItems;
+        for (const Item& item : allItems) {
+            next->itemDefinitions.add(item);
+        }
+    }
+    DataGeneration::publish(next);
+    dataGeneration = next->number;
+    
+    // Battles started after an edit to the files pick up the new data
+    if (!fromDex) {
+        dataWatcher.reset(new DataWatcher(DataFiles()));
+    }
     initializeEnvironments();
 }
 
@@ -43,7 +72,10 @@ void Game::displayStartScreen() {
     
     int choice;
     std::cout << "Enter your choice: ";
-    std::cin >> choice;
+    if (!(std::cin >> choice)) {
+        // The input has ended; exit rather than asking forever
+        choice = 3;
+    }
     
     switch(choice) {
         case 1:
@@ -70,15 +102,41 @@ void Game::playGame() {
     bool continueGame = true;
     
     while (continueGame) {
+        // The battle keeps the data it starts with, even if the files are reloaded meanwhile
+        DataGeneration::refresh();
+        GenerationPin dataPin;
+        if (dataPin.get().number != dataGeneration) {
+            allPokemon = dataPin.get().pokemon;
+            allItems = dataPin.get().items;
+            dataGeneration = dataPin.get().number;
+            std::cout << "Data files reloaded." << std::endl;
+        }
+        
         // Generate enemy team for the battle
         generateEnemyTeam();
         
         // Create and start a battle
-        Battle battle(playerTeam, enemyTeam, currentEnvironment, difficulty);
-        BattleResult result = battle.start();
+        // The enemy searches ahead as far as the difficulty allows
+        ConsolePolicy playerPolicy;
+        enemyPolicy.setBudget(aiBudget);
         
-        // Record battle results
-        recordLog.addEntry(result);
+        // Every battle is kept as a replay: its seed, both teams and the decisions made
+        uint64_t seed = rng();
+        BattleRecord replay = makeBattleRecord(playerTeam, enemyTeam, difficulty, currentEnvironment, seed, 0);
+        RecordingPolicy recordedPlayer(playerPolicy, replay.decisions);
+        RecordingPolicy recordedEnemy(enemyPolicy, replay.decisions);
+        Battle battle(playerTeam, enemyTeam, difficulty, Environment(currentEnvironment),
+                      recordedPlayer, recordedEnemy, seed, &std::cout);
+        battle.setTurnLimit(0);
+        StatsEventSink statsSink(recordLog.stats);
+        battle.addEventSink(statsSink);
+        // The stats sink counts the battle in the record log as it is fought
+        bool playerWon = battle.start();
+        replay.turns = battle.getTurnCount();
+        replay.playerWon = playerWon;
+        if (!recordLog.addBattle(replay, REPLAY_DEFAULT_FILE)) {
+            std::cerr << "Could not save the replay to " << REPLAY_DEFAULT_FILE << std::endl;
+        }
         
         // Ask if player wants to continue
         std::cout << "\nDo you want to continue playing?" << std::endl;
@@ -90,15 +148,16 @@ void Game::playGame() {
         
         int choice;
         std::cout << "Enter your choice: ";
-        std::cin >> choice;
+        if (!(std::cin >> choice)) {
+            // The input has ended; exit rather than battling forever
+            choice = 5;
+        }
         
         switch(choice) {
             case 1:
                 // Continue with current team
                 // Heal all Pokemon before next battle
-                for (auto& pokemon : playerTeam.members) {
-                    pokemon.heal();
-                }
+                playerTeam.resetTeam();
                 break;
             case 2:
                 changeTeam();
@@ -122,8 +181,8 @@ void Game::playGame() {
 
 void Game::changeTeam() {
     std::cout << "Current team:" << std::endl;
-    for (size_t i = 0; i < playerTeam.members.size(); i++) {
-        std::cout << (i+1) << ". " << playerTeam.members[i].name << " (Lv. " << playerTeam.members[i].level << ")" << std::endl;
+    for (int i = 0; i < playerTeam.size(); i++) {
+        std::cout << (i+1) << ". " << playerTeam.getMember(i).getName() << " (Lv. " << playerTeam.getMember(i).level << ")" << std::endl;
     }
     
     std::cout << "\nDo you want to select a completely new team or modify current team?" << std::endl;
@@ -142,18 +201,18 @@ void Game::changeTeam() {
         case 2:
             // Modify team logic
             displayPokemonList();
-            std::cout << "Select which Pokemon to replace (1-" << playerTeam.members.size() << "): ";
+            std::cout << "Select which Pokemon to replace (1-" << playerTeam.size() << "): ";
             int replaceIndex;
             std::cin >> replaceIndex;
             
-            if (replaceIndex >= 1 && replaceIndex <= static_cast<int>(playerTeam.members.size())) {
+            if (replaceIndex >= 1 && replaceIndex <= playerTeam.size()) {
                 std::cout << "Select new Pokemon by number: ";
                 int newPokemonIndex;
                 std::cin >> newPokemonIndex;
                 
                 if (newPokemonIndex >= 1 && newPokemonIndex <= static_cast<int>(allPokemon.size())) {
-                    playerTeam.members[replaceIndex - 1] = allPokemon[newPokemonIndex - 1];
-                    std::cout << allPokemon[newPokemonIndex - 1].name << " added to your team!" << std::endl;
+                    playerTeam.setMember(replaceIndex - 1, allPokemon[newPokemonIndex - 1]);
+                    std::cout << allPokemon[newPokemonIndex - 1].getName() << " added to your team!" << std::endl;
                 } else {
                     std::cout << "Invalid Pokemon selection." << std::endl;
                 }
@@ -172,7 +231,7 @@ void Game::changeTeam() {
 
 void Game::displayRecordLog() {
     std::cout << "======== BATTLE RECORD LOG ========" << std::endl;
-    recordLog.displayEntries();
+    recordLog.displayStats();
     std::cout << "==================================" << std::endl;
     
     std::cout << "Press Enter to continue...";
@@ -181,7 +240,7 @@ void Game::displayRecordLog() {
 }
 
 void Game::selectTeam() {
-    playerTeam.members.clear();
+    playerTeam.clearMembers();
     
     std::cout << "Select your team (max 6 Pokemon):" << std::endl;
     displayPokemonList();
@@ -196,73 +255,67 @@ void Game::selectTeam() {
         }
         
         if (choice >= 1 && choice <= static_cast<int>(allPokemon.size())) {
-            playerTeam.members.push_back(allPokemon[choice - 1]);
-            std::cout << allPokemon[choice - 1].name << " added to your team!" << std::endl;
+            playerTeam.addPokemon(allPokemon[choice - 1]);
+            std::cout << allPokemon[choice - 1].getName() << " added to your team!" << std::endl;
         } else {
             std::cout << "Invalid choice. Please try again." << std::endl;
             i--; // Retry this position
         }
     }
     
-    if (playerTeam.members.empty()) {
+    if (playerTeam.size() == 0) {
         std::cout << "You must select at least one Pokemon!" << std::endl;
         selectTeam();
     }
     
-    std::cout << "Team selected! You have " << playerTeam.members.size() << " Pokemon." << std::endl;
+    std::cout << "Team selected! You have " << playerTeam.size() << " Pokemon." << std::endl;
 }
 
 void Game::generateEnemyTeam() {
-    enemyTeam.members.clear();
-    
-    // Get random number generator
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::default_random_engine generator(seed);
+    enemyTeam.clearMembers();
     
     // Determine enemy team size (scaled to player team, but at least 1)
-    int enemyTeamSize = std::max(1, static_cast<int>(playerTeam.members.size() * difficulty));
+    int enemyTeamSize = std::max(1, static_cast<int>(playerTeam.size() * difficulty));
     enemyTeamSize = std::min(enemyTeamSize, 6); // Cap at 6 Pokemon
     
-    // Create a uniform distribution for Pokemon selection
-    std::uniform_int_distribution<int> distribution(0, allPokemon.size() - 1);
-    
     // Select random Pokemon for enemy team
     for (int i = 0; i < enemyTeamSize; i++) {
-        int index = distribution(generator);
+        int index = rng.uniformInt(0, static_cast<int>(allPokemon.size()) - 1);
         Pokemon enemyPokemon = allPokemon[index];
         
         // Scale level based on difficulty and player's Pokemon
         float avgPlayerLevel = 0;
-        for (const auto& pokemon : playerTeam.members) {
+        for (const auto& pokemon : playerTeam.getMembers()) {
             avgPlayerLevel += pokemon.level;
         }
-        avgPlayerLevel /= playerTeam.members.size();
+        avgPlayerLevel /= playerTeam.size();
         
         int enemyLevel = static_cast<int>(avgPlayerLevel * difficulty);
         enemyLevel = std::max(1, std::min(enemyLevel, 100)); // Keep level between 1-100
         
-        enemyPokemon.setLevel(enemyLevel);
-        enemyTeam.members.push_back(enemyPokemon);
+        enemyPokemon.setLevel(enemyLevel, rng);
+        enemyPokemon.resetHp();
+        enemyTeam.addPokemon(enemyPokemon);
     }
     
-    std::cout << "Enemy team generated with " << enemyTeam.members.size() << " Pokemon!" << std::endl;
+    std::cout << "Enemy team generated with " << enemyTeam.size() << " Pokemon!" << std::endl;
 }
 
 void Game::displayPokemonList() {
     std::cout << "Available Pokemon:" << std::endl;
     for (size_t i = 0; i < allPokemon.size(); i++) {
-        const auto& pokemon = allPokemon[i];
-        std::cout << (i+1) << ". " << pokemon.name 
-                  << " (Type: " << getPokemonTypeName(pokemon.type1);
+        const Species& species = allPokemon[i].getSpecies();
+        std::cout << (i+1) << ". " << species.name 
+                  << " (Type: " << typeToString(species.primaryType);
         
-        if (pokemon.type2 != PokemonType::NONE) {
-            std::cout << "/" << getPokemonTypeName(pokemon.type2);
+        if (species.secondaryType != PokemonType::NONE) {
+            std::cout << "/" << typeToString(species.secondaryType);
         }
         
-        std::cout << ", Base stats: HP=" << pokemon.baseHP
-                  << ", Atk=" << pokemon.baseAttack
-                  << ", Def=" << pokemon.baseDefense
-                  << ", Spd=" << pokemon.baseSpeed
+        std::cout << ", Base stats: HP=" << species.baseHp
+                  << ", Atk=" << species.baseAttack
+                  << ", Def=" << species.baseDefense
+                  << ", Spd=" << species.baseSpeed
                   << ")" << std::endl;
     }
 }
@@ -281,23 +334,33 @@ void Game::selectDifficulty() {
     switch(choice) {
         case 1:
             difficulty = 0.75f;
+            aiBudget.maxDepth = 1;
+            aiBudget.timeLimitMs = 5;
             std::cout << "Difficulty set to Easy." << std::endl;
             break;
         case 2:
             difficulty = 1.0f;
+            aiBudget.maxDepth = 2;
+            aiBudget.timeLimitMs = 15;
             std::cout << "Difficulty set to Normal." << std::endl;
             break;
         case 3:
             difficulty = 1.25f;
+            aiBudget.maxDepth = 4;
+            aiBudget.timeLimitMs = 30;
             std::cout << "Difficulty set to Hard." << std::endl;
             break;
         case 4:
             difficulty = 1.5f;
+            aiBudget.maxDepth = 8;
+            aiBudget.timeLimitMs = 50;
             std::cout << "Difficulty set to Very Hard." << std::endl;
             break;
         default:
             std::cout << "Invalid choice. Setting difficulty to Normal." << std::endl;
             difficulty = 1.0f;
+            aiBudget.maxDepth = 2;
+            aiBudget.timeLimitMs = 15;
             break;
     }
 }
@@ -314,29 +377,7 @@ void Game::selectEnvironment() {
     std::cin >> choice;
     
     if (choice >= 1 && choice <= static_cast<int>(allEnvironments.size())) {
-        // Set current environment based on user selection
-        // This is a simplified version - you may need to adapt this to your Environment class structure
-        switch (choice) {
-            case 1:
-                currentEnvironment = BattleEnvironment::NORMAL;
-                break;
-            case 2:
-                currentEnvironment = BattleEnvironment::FIRE;
-                break;
-            case 3:
-                currentEnvironment = BattleEnvironment::WATER;
-                break;
-            case 4:
-                currentEnvironment = BattleEnvironment::GRASS;
-                break;
-            case 5:
-                currentEnvironment = BattleEnvironment::ELECTRIC;
-                break;
-            default:
-                currentEnvironment = BattleEnvironment::NORMAL;
-                break;
-        }
-        
+        currentEnvironment = allEnvironments[choice - 1].getType();
         std::cout << "Environment set to " << allEnvironments[choice - 1].getName() << std::endl;
     } else {
         std::cout << "Invalid choice. Setting environment to Normal." << std::endl;
@@ -357,6 +398,45 @@ void Game::displayTitleArt() {
     )" << std::endl;
 }
 
+bool Game::loadDexData(const std::string& filename) {
+    if (!std::ifstream(filename)) {
+        return false;
+    }
+    
+    try {
+        // The image is checked in place and its records copied into the registries; no text is parsed
+        DexImage image(filename);
+        importDex(image, allPokemon, allItems);
+        
+        if (allPokemon.empty()) {
+            throw std::runtime_error("No Pokemon in dex!");
+        }
+        
+        std::cout << "Loaded " << allPokemon.size() << " Pokemon, " << image.moveCount() << " moves and "
+                  << allItems.size() << " items from " << filename << "." << std::endl;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading dex: " << e.what() << std::endl;
+        std::cerr << "Falling back to the data files..." << std::endl;
+        return false;
+    }
+}
+
+void Game::loadMoveData() {
+    try {
+        // Moves are interned once; Pokemon only hold their MoveIds
+        size_t count = MoveRegistry::instance().loadFromFile("moves.csv");
+        
+        if (count == 0) {
+            throw std::runtime_error("No moves loaded from file!");
+        }
+        
+        std::cout << "Loaded " << count << " moves from file." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading move data: " << e.what() << std::endl;
+    }
+}
+
 void Game::loadPokemonData() {
     try {
         // Use DataLoader to load Pokemon from CSV file
@@ -374,14 +454,24 @@ void Game::loadPokemonData() {
         
         // Create some default Pokemon if file loading fails
         allPokemon = {
-            Pokemon("Bulbasaur", 1, PokemonType::GRASS, PokemonType::POISON, 45, 49, 49, 45),
-            Pokemon("Charmander", 4, PokemonType::FIRE, PokemonType::NONE, 39, 52, 43, 65),
-            Pokemon("Squirtle", 7, PokemonType::WATER, PokemonType::NONE, 44, 48, 65, 43),
-            Pokemon("Pikachu", 25, PokemonType::ELECTRIC, PokemonType::NONE, 35, 55, 40, 90)
+            Pokemon("Bulbasaur", 45, 49, 49, 65, 65, 45, PokemonType::GRASS, PokemonType::POISON),
+            Pokemon("Charmander", 39, 52, 43, 60, 50, 65, PokemonType::FIRE, PokemonType::NONE),
+            Pokemon("Squirtle", 44, 48, 65, 50, 64, 43, PokemonType::WATER, PokemonType::NONE),
+            Pokemon("Pikachu", 35, 55, 40, 50, 50, 90, PokemonType::ELECTRIC, PokemonType::NONE)
         };
         
-        // Add some moves to default Pokemon
-        // This would depend on your Move class implementation
+        // Every default Pokemon knows Tackle and one move of its own type
+        const Move typeMoves[] = {
+            Move("Vine Whip", PokemonType::GRASS, MoveCategory::PHYSICAL, 45, 100, 25, StatusEffect::NONE, 0),
+            Move("Ember", PokemonType::FIRE, MoveCategory::SPECIAL, 40, 100, 25, StatusEffect::BURN, 10),
+            Move("Water Gun", PokemonType::WATER, MoveCategory::SPECIAL, 40, 100, 25, StatusEffect::NONE, 0),
+            Move("Thunder Shock", PokemonType::ELECTRIC, MoveCategory::SPECIAL, 40, 100, 30, StatusEffect::PARALYSIS, 10)
+        };
+        for (size_t i = 0; i < allPokemon.size(); i++) {
+            allPokemon[i].addMove(Move("Tackle", PokemonType::NORMAL, MoveCategory::PHYSICAL, 40, 100, 35,
+                                       StatusEffect::NONE, 0));
+            allPokemon[i].addMove(typeMoves[i]);
+        }
     }
 }
 
@@ -402,22 +492,21 @@ void Game::loadItemData() {
         
         // Create some default items if file loading fails
         allItems = {
-            Item("Potion", ItemType::HEALING, 20),
-            Item("Super Potion", ItemType::HEALING, 50),
-            Item("Hyper Potion", ItemType::HEALING, 200),
-            Item("Max Potion", ItemType::HEALING, 999),
-            Item("Revive", ItemType::REVIVAL, 0)
+            Item("Potion", 20),
+            Item("Super Potion", 50),
+            Item("Hyper Potion", 200),
+            Item("Max Potion", 999),
+            Item("Revive", 0)
         };
+        allItems.back().type = ItemType::REVIVE;
     }
 }
 
 void Game::initializeEnvironments() {
-    // Create battle environments
-    allEnvironments = {
-        Environment("Normal", "Standard battle environment", BattleEnvironment::NORMAL),
-        Environment("Fire", "Hot environment that boosts Fire-type moves", BattleEnvironment::FIRE),
-        Environment("Water", "Aquatic environment that boosts Water-type moves", BattleEnvironment::WATER),
-        Environment("Grass", "Grassy environment that boosts Grass-type moves", BattleEnvironment::GRASS),
-        Environment("Electric", "Charged environment that boosts Electric-type moves", BattleEnvironment::ELECTRIC)
-    };
+    // One of each battle environment, in menu order
+    allEnvironments.clear();
+    for (int type = static_cast<int>(BattleEnvironment::NORMAL);
+         type <= static_cast<int>(BattleEnvironment::PSYCHIC_TERRAIN); type++) {
+        allEnvironments.push_back(Environment(static_cast<BattleEnvironment>(type)));
+    }
 }
\ No newline at end of file
@@ -2,10 +2,15 @@
 #define GAME_H
 
 #include <vector>
+#include <memory>
+#include <cstdint>
 #include "pokemon.h"
 #include "team.h"
 #include "record_log.h"
 #include "environment.h"
+#include "rng.h"
+#include "ai_search.h"
+#include "data_watcher.h"
 
 /**
  * @brief Main game class
@@ -34,8 +39,13 @@ private:
     Team playerTeam;
     Team enemyTeam;
     float difficulty;
+    SearchBudget aiBudget;
+    ExpectiminimaxPolicy enemyPolicy;   // The enemy AI, kept from battle to battle
     RecordLog recordLog;
     BattleEnvironment currentEnvironment;
+    Rng rng;
+    std::unique_ptr<DataWatcher> dataWatcher;   // Reloads the data files when they change (not used with a dex)
+    uint64_t dataGeneration;                    // Generation allPokemon and allItems came from
     
     /**
      * @brief Initialize game data
@@ -97,6 +107,18 @@ private:
      */
     void loadPokemonData();
     
+    /**
+     * @brief Load Pokemon, moves and items from a compiled dex
+     * @param filename The dex file
+     * @return False if there is no usable dex (the data files are loaded instead)
+     */
+    bool loadDexData(const std::string& filename);
+    
+    /**
+     * @brief Load move data into the global move registry
+     */
+    void loadMoveData();
+    
     /**
      * @brief Load items from file or create default
      */
@@ -0,0 +1,51 @@
+#include "inventory.h"
+
+// Constructor
+Inventory::Inventory() : stacks(), stackCount(0) {
+}
+
+// Add items, stacking them with identical ones
+bool Inventory::add(ItemId item, int amount) {
+    if (item == INVALID_ITEM_ID || amount <= 0) {
+        return false;
+    }
+    int stack = find(item);
+    if (stack >= 0) {
+        if (stacks[stack].count + amount > MAX_COUNT) {
+            return false;
+        }
+        stacks[stack].count = static_cast<uint16_t>(stacks[stack].count + amount);
+        return true;
+    }
+    if (stackCount == MAX_STACKS || amount > MAX_COUNT) {
+        return false;
+    }
+    stacks[stackCount++] = {item, static_cast<uint16_t>(amount)};
+    return true;
+}
+
+// Use up one item of a stack; an empty stack is swapped out for the last one
+void Inventory::takeOne(int stack) {
+    if (--stacks[stack].count == 0) {
+        stacks[stack] = stacks[--stackCount];
+    }
+}
+
+// Find the stack holding an item
+int Inventory::find(ItemId item) const {
+    for (int i = 0; i < stackCount; ++i) {
+        if (stacks[i].item == item) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Get the number of items in every stack
+int Inventory::totalCount() const {
+    int total = 0;
+    for (int i = 0; i < stackCount; ++i) {
+        total += stacks[i].count;
+    }
+    return total;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "item_registry.h"
+
+/**
+ * @brief A team's bag: stacks of identical items in a small fixed table
+ *
+ * Each stack is an item ID and a count, so copying a team copies a few
+ * dozen bytes instead of every item's strings. Using an item is O(1): a
+ * stack that runs out is replaced by the last one, so stack indices of
+ * later stacks may change after a use.
+ */
+class Inventory {
+public:
+    static constexpr int MAX_STACKS = 16;
+    static constexpr int MAX_COUNT = 0xFFFF;
+
+    Inventory();
+
+    /**
+     * @brief Add items, stacking them with identical ones
+     * @param item ID of the item
+     * @param amount Number of items to add
+     * @return False (and nothing added) if the stack would overflow or every stack is taken
+     */
+    bool add(ItemId item, int amount = 1);
+
+    /**
+     * @brief Use up one item of a stack
+     * @param stack Index of the stack (must be valid)
+     */
+    void takeOne(int stack);
+
+    /**
+     * @brief Find the stack holding an item
+     * @param item ID of the item
+     * @return The stack's index, or -1 if there is none
+     */
+    int find(ItemId item) const;
+
+    /**
+     * @brief Remove every item
+     */
+    void clear() { stackCount = 0; }
+
+    /**
+     * @brief Check if the bag is empty
+     * @return True if there are no items
+     */
+    bool empty() const { return stackCount == 0; }
+
+    /**
+     * @brief Get the number of stacks
+     * @return Stack count
+     */
+    int size() const { return stackCount; }
+
+    /**
+     * @brief Get the item of a stack
+     * @param stack Index of the stack (must be valid)
+     * @return ID of the item
+     */
+    ItemId getItemId(int stack) const { return stacks[stack].item; }
+
+    /**
+     * @brief Get the item definition of a stack
+     * @param stack Index of the stack (must be valid)
+     * @return The item, from the item registry
+     */
+    const Item& getItem(int stack) const { return itemRegistry().get(stacks[stack].item); }
+
+    /**
+     * @brief Get the number of items in a stack
+     * @param stack Index of the stack (must be valid)
+     * @return Item count (at least 1)
+     */
+    int getCount(int stack) const { return stacks[stack].count; }
+
+    /**
+     * @brief Get the number of items in every stack
+     * @return Total item count
+     */
+    int totalCount() const;
+
+private:
+    struct Stack {
+        ItemId item;
+        uint16_t count;
+    };
+
+    std::array<Stack, MAX_STACKS> stacks;
+    uint8_t stackCount;
+};
+
+static_assert(std::is_trivially_copyable<Inventory>::value, "inventories are copied with every team");
+
+#endif // INVENTORY_H
\ No newline at end of file
@@ -4,19 +4,19 @@
 // Constructor for healing item
 Item::Item(const std::string& n, int h)
     : name(n), type(ItemType::POTION), healAmount(h), healStatus(StatusEffect::NONE),
-      boostStat(""), boostAmount(0) {
+      boostStat(Stat::NONE), boostAmount(0) {
 }
 
 // Constructor for status healing item
 Item::Item(const std::string& n, StatusEffect s)
     : name(n), type(ItemType::STATUS_HEAL), healAmount(0), healStatus(s),
-      boostStat(""), boostAmount(0) {
+      boostStat(Stat::NONE), boostAmount(0) {
 }
 
 // Constructor for stat boost item
 Item::Item(const std::string& n, const std::string& statName, int boost)
     : name(n), type(ItemType::STAT_BOOST), healAmount(0), healStatus(StatusEffect::NONE),
-      boostStat(statName), boostAmount(boost) {
+      boostStat(stringToStat(statName)), boostAmount(boost) {
 }
 
 // Check if item is a healing item
@@ -57,7 +57,7 @@ std::string Item::getDescription() const {
             break;
             
         case ItemType::STAT_BOOST:
-            ss << "Raises " << boostStat << " by " << boostAmount;
+            ss << "Raises " << statToString(boostStat) << " by " << boostAmount;
             break;
             
         case ItemType::REVIVE:
@@ -3,6 +3,7 @@
 
 #include <string>
 #include "status.h"
+#include "stats.h"
 
 /**
  * @brief Enum representing different item types
@@ -36,7 +37,7 @@ public:
     /**
      * @brief Constructor for a stat-boosting item
      * @param n Name of the item
-     * @param statName The name of the stat to boost
+     * @param statName The name of the stat to boost (resolved to a Stat once, here)
      * @param boost The amount to boost the stat by
      */
     Item(const std::string& n, const std::string& statName, int boost);
@@ -51,7 +52,7 @@ public:
     StatusEffect healStatus;
     
     // Stat boost properties
-    std::string boostStat;
+    Stat boostStat;
     int boostAmount;
     
     /**
@@ -0,0 +1,76 @@
+#include "item_registry.h"
+#include "data_generation.h"
+#include <stdexcept>
+
+namespace {
+
+// Every property of an item, as one lookup key
+std::string definitionKey(const Item& item) {
+    std::string key = item.name;
+    key += '\0';
+    key += std::to_string(static_cast<int>(item.type));
+    key += ',';
+    key += std::to_string(item.healAmount);
+    key += ',';
+    key += std::to_string(static_cast<int>(item.healStatus));
+    key += ',';
+    key += std::to_string(static_cast<int>(item.boostStat));
+    key += ',';
+    key += std::to_string(item.boostAmount);
+    return key;
+}
+
+} // namespace
+
+// Get the registry of the calling thread's data generation
+ItemRegistry& ItemRegistry::instance() {
+    return DataGeneration::active().itemDefinitions;
+}
+
+// Copy a registry, keeping every ID
+ItemRegistry::ItemRegistry(const ItemRegistry& other) {
+    std::lock_guard<std::mutex> lock(other.mutex);
+    items = other.items;
+    byDefinition = other.byDefinition;
+}
+
+// Register an item definition, or find an identical one
+ItemId ItemRegistry::add(const Item& item) {
+    std::string key = definitionKey(item);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byDefinition.find(key);
+    if (it != byDefinition.end()) {
+        return it->second;
+    }
+    if (sealed) {
+        throw std::runtime_error("Cannot register the item " + item.name + ": its data generation is published");
+    }
+    if (items.size() >= INVALID_ITEM_ID) {
+        return INVALID_ITEM_ID;
+    }
+
+    ItemId id = static_cast<ItemId>(items.size());
+    items.push_back(item);
+    byDefinition.emplace(std::move(key), id);
+    return id;
+}
+
+// Look up an item definition
+ItemId ItemRegistry::find(const Item& item) const {
+    std::string key = definitionKey(item);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byDefinition.find(key);
+    return it != byDefinition.end() ? it->second : INVALID_ITEM_ID;
+}
+
+// Refuse every later change
+void ItemRegistry::seal() {
+    std::lock_guard<std::mutex> lock(mutex);
+    sealed = true;
+}
+
+// Get the number of registered definitions
+size_t ItemRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return items.size();
+}
\ No newline at end of file
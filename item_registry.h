@@ -0,0 +1,93 @@
+#ifndef ITEM_REGISTRY_H
+#define ITEM_REGISTRY_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include "item.h"
+
+/**
+ * @brief Compact handle of an item definition in the item registry
+ */
+using ItemId = uint16_t;
+
+constexpr ItemId INVALID_ITEM_ID = 0xFFFF;
+
+/**
+ * @brief Table of every item definition in use, interned by value
+ *
+ * Two items share an ID only if every property matches, so an ID always
+ * means exactly one item: a reload that changes a potion registers a new
+ * definition instead of altering the one inventories already hold. Each
+ * DataGeneration owns one registry, sealed when the generation is published,
+ * and the next generation starts from a copy, so IDs stay valid across
+ * reloads.
+ */
+class ItemRegistry {
+public:
+    ItemRegistry() = default;
+
+    /**
+     * @brief Copy a registry, keeping every ID (used to start the next data generation)
+     * @param other The registry to copy
+     */
+    ItemRegistry(const ItemRegistry& other);
+    ItemRegistry& operator=(const ItemRegistry&) = delete;
+
+    /**
+     * @brief Get the registry of the calling thread's data generation
+     * @return The registry
+     */
+    static ItemRegistry& instance();
+
+    /**
+     * @brief Register an item definition, or find it if an identical one exists
+     * @param item The item
+     * @return The item's ID (INVALID_ITEM_ID if the registry is full)
+     * @throws std::runtime_error if the item is new and the registry is sealed
+     */
+    ItemId add(const Item& item);
+
+    /**
+     * @brief Look up an item definition
+     * @param item The item
+     * @return The ID of an identical item, or INVALID_ITEM_ID if there is none
+     */
+    ItemId find(const Item& item) const;
+
+    /**
+     * @brief Get an item definition
+     * @param id The item's ID (must be valid)
+     * @return The item (valid until the next registration)
+     */
+    const Item& get(ItemId id) const { return items[id]; }
+
+    /**
+     * @brief Refuse every later change (called when the registry's data generation is published)
+     */
+    void seal();
+
+    /**
+     * @brief Get the number of registered definitions
+     * @return Definition count
+     */
+    size_t size() const;
+
+private:
+    std::vector<Item> items;
+    std::unordered_map<std::string, ItemId> byDefinition;
+    bool sealed = false;        // Set once the generation is published; copies start unsealed
+    mutable std::mutex mutex;   // Guards registration only
+};
+
+/**
+ * @brief Shorthand for the item registry of the calling thread's data generation
+ * @return The registry
+ */
+inline ItemRegistry& itemRegistry() {
+    return ItemRegistry::instance();
+}
+
+#endif // ITEM_REGISTRY_H
\ No newline at end of file
@@ -1,15 +1,87 @@
 #include "game.h"
+#include "dex_image.h"
+#include "data_generation.h"
+#include "record_log.h"
+#include "metrics.h"
 #include <iostream>
+#include <string>
+#include <memory>
 
-int main() {
+int main(int argc, char* argv[]) {
+    // pokemon --compile-dex [output]: build the binary dex from the data files and exit
+    if (argc > 1 && std::string(argv[1]) == "--compile-dex") {
+        std::string output = argc > 2 ? argv[2] : DEX_DEFAULT_FILE;
+        try {
+            compileDex("pokemon.csv", "moves.csv", "items.csv", output);
+            std::cout << "Wrote " << output << std::endl;
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // pokemon --replay [file] [number]: fight a recorded battle again (the last one by default)
+    if (argc > 1 && std::string(argv[1]) == "--replay") {
+        std::string file = argc > 2 ? argv[2] : REPLAY_DEFAULT_FILE;
+        try {
+            RecordLog log;
+            if (!log.loadBattles(file) || log.battles.empty()) {
+                std::cerr << "Error: no replays could be read from " << file << std::endl;
+                return 1;
+            }
+            size_t number = argc > 3 ? std::stoul(argv[3]) : log.battles.size();
+            if (number < 1 || number > log.battles.size()) {
+                std::cerr << "Error: " << file << " holds battles 1 to " << log.battles.size() << std::endl;
+                return 1;
+            }
+            DataGeneration::publish(DataGeneration::load(DataFiles(), DataGeneration::current().get()));
+            const BattleRecord& record = log.battles[number - 1];
+            bool playerWon = replayBattle(record, &std::cout);
+            if (playerWon != record.playerWon) {
+                std::cerr << "Warning: the replay ended differently from the recorded battle" << std::endl;
+                return 1;
+            }
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    
+    // pokemon [--metrics file] [--metrics-port port]: time the game, then write the metrics to a file
+    // (JSON if it ends in .json, Prometheus text otherwise) or serve them on 127.0.0.1
+    std::string metricsFile;
+    std::unique_ptr<MetricsServer> metricsServer;
+    for (int i = 1; i + 1 < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--metrics") {
+            metricsFile = argv[++i];
+            Metrics::setTiming(true);
+        } else if (option == "--metrics-port") {
+            metricsServer.reset(new MetricsServer(std::atoi(argv[++i])));
+            Metrics::setTiming(true);
+        }
+    }
+    auto writeMetrics = [&metricsFile]() {
+        if (metricsFile.empty()) {
+            return;
+        }
+        bool json = metricsFile.size() >= 5 && metricsFile.compare(metricsFile.size() - 5, 5, ".json") == 0;
+        if (!Metrics::writeToFile(metricsFile, json ? MetricsFormat::JSON : MetricsFormat::PROMETHEUS)) {
+            std::cerr << "Could not write the metrics to " << metricsFile << std::endl;
+        }
+    };
+    
     try {
         // Create and start the game
         Game game;
-        game.initialize();
-        game.run();
+        game.start();
+        writeMetrics();
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
+        writeMetrics();
         return 1;
     }
 }
\ No newline at end of file
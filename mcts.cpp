@@ -0,0 +1,287 @@
+#include "mcts.h"
+#include "battle.h"
+#include "data_generation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+// A child reached through one particular sequence of chance outcomes
+struct OutcomeChild {
+    uint64_t key;
+    int node;
+};
+
+// One action of a decision node
+struct Edge {
+    int action = 0;
+    int visits = 0;
+    double valueSum = 0.0;              // From the point of view of the node's mover
+    std::vector<OutcomeChild> children;
+};
+
+// A point where one side picks an action
+struct Node {
+    BattleSide mover = BattleSide::PLAYER;
+    int visits = 0;
+    std::vector<Edge> edges;
+};
+
+// Private search tree of one thread
+class SearchTree {
+public:
+    SearchTree(const BattleModel& battleModel, const BattleState& rootState, BattleSide side, const MctsBudget& searchBudget,
+               uint64_t seed)
+        : model(battleModel), root(rootState), self(side), budget(searchBudget), rng(seed) {
+        // Each playout adds at most one node, so a playout budget bounds the tree too
+        nodeLimit = std::max(1, budget.maxNodes);
+        if (budget.playouts > 0) {
+            nodeLimit = std::min(nodeLimit, budget.playouts + 1);
+        }
+        nodes.reserve(std::min(nodeLimit, 1024));
+        nodes.push_back(makeNode(root));
+    }
+
+    // Run one selection, expansion, playout and backpropagation
+    void iterate() {
+        BattleState state = root;
+        int nodeIndex = 0;
+        path.clear();
+        float value;
+
+        while (true) {
+            // A side with nothing to do ends the descent; its position is simply evaluated
+            if (nodes[nodeIndex].edges.empty()) {
+                value = model.evaluate(state, self);
+                break;
+            }
+            int edgeIndex = selectEdge(nodes[nodeIndex]);
+            path.push_back(std::make_pair(nodeIndex, edgeIndex));
+            int action = nodes[nodeIndex].edges[edgeIndex].action;
+
+            // Sample the action's outcome, then the status checks up to the next decision
+            model.actionOutcomes(state, action, outcomes);
+            int index = BattleModel::sampleOutcome(outcomes, rng);
+            uint64_t key = static_cast<uint64_t>(index) + 1;
+            state = outcomes[index].state;
+            while (!model.isTerminal(state)) {
+                model.statusCheckOutcomes(state, outcomes);
+                index = BattleModel::sampleOutcome(outcomes, rng);
+                key = key * 131 + static_cast<uint64_t>(index) + 1;
+                bool canMove = outcomes[index].canMove;
+                state = outcomes[index].state;
+                if (canMove) {
+                    break;
+                }
+            }
+
+            if (model.isTerminal(state)) {
+                value = model.evaluate(state, self);
+                break;
+            }
+
+            // Follow the child for this outcome sequence, or expand it (while the tree has room) and play out
+            std::vector<OutcomeChild>& children = nodes[nodeIndex].edges[edgeIndex].children;
+            auto child = std::find_if(children.begin(), children.end(),
+                                      [key](const OutcomeChild& c) { return c.key == key; });
+            if (child == children.end()) {
+                if (static_cast<int>(nodes.size()) < nodeLimit) {
+                    int created = static_cast<int>(nodes.size());
+                    nodes.push_back(makeNode(state));
+                    nodes[nodeIndex].edges[edgeIndex].children.push_back(OutcomeChild{key, created});
+                }
+                value = playout(state);
+                break;
+            }
+            nodeIndex = child->node;
+        }
+
+        // Every node stores values from its own mover's point of view
+        for (const auto& step : path) {
+            Node& node = nodes[step.first];
+            Edge& edge = node.edges[step.second];
+            node.visits++;
+            edge.visits++;
+            edge.valueSum += node.mover == self ? value : -value;
+        }
+    }
+
+    // Visit counts of the root actions
+    const std::vector<Edge>& rootEdges() const {
+        return nodes[0].edges;
+    }
+
+private:
+    const BattleModel& model;
+    BattleState root;
+    BattleSide self;
+    MctsBudget budget;
+    Rng rng;
+    int nodeLimit;
+    std::vector<Node> nodes;
+    std::vector<std::pair<int, int>> path;
+    std::vector<ModelOutcome> outcomes;
+    std::vector<int> actions;
+
+    // Create a decision node for the side to move in a state
+    Node makeNode(const BattleState& state) {
+        Node node;
+        node.mover = model.sideToMove(state);
+        model.legalActions(state, node.mover, actions);
+        for (int action : actions) {
+            Edge edge;
+            edge.action = action;
+            node.edges.push_back(edge);
+        }
+        return node;
+    }
+
+    // UCT selection; untried actions come first
+    int selectEdge(const Node& node) const {
+        int best = 0;
+        double bestScore = -1e300;
+        double logVisits = std::log(static_cast<double>(std::max(1, node.visits)));
+        for (size_t i = 0; i < node.edges.size(); ++i) {
+            const Edge& edge = node.edges[i];
+            if (edge.visits == 0) {
+                return static_cast<int>(i);
+            }
+            double score = edge.valueSum / edge.visits + budget.exploration * std::sqrt(logVisits / edge.visits);
+            if (score > bestScore) {
+                bestScore = score;
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    }
+
+    // Random moves until the battle ends or the step limit is reached; the side to move has passed its status check
+    float playout(BattleState state) {
+        bool checked = true;
+        for (int step = 0; step < budget.rolloutSteps && !model.isTerminal(state); ++step) {
+            if (!checked) {
+                model.statusCheckOutcomes(state, outcomes);
+                int index = BattleModel::sampleOutcome(outcomes, rng);
+                bool canMove = outcomes[index].canMove;
+                state = outcomes[index].state;
+                if (!canMove) {
+                    continue;
+                }
+            }
+            checked = false;
+
+            // Playouts only attack; random switching just wastes turns
+            model.legalActions(state, model.sideToMove(state), actions);
+            if (actions.empty()) {
+                break;
+            }
+            int moveCount = static_cast<int>(std::count_if(actions.begin(), actions.end(),
+                                                           [](int a) { return a < MODEL_SWITCH_BASE; }));
+            int choices = moveCount > 0 ? moveCount : static_cast<int>(actions.size());
+            int action = actions[rng.uniformInt(0, choices - 1)];
+
+            model.actionOutcomes(state, action, outcomes);
+            state = outcomes[BattleModel::sampleOutcome(outcomes, rng)].state;
+        }
+        return model.evaluate(state, self);
+    }
+};
+
+} // namespace
+
+// Constructor
+MctsPolicy::MctsPolicy(uint64_t seed, const MctsBudget& searchBudget) : rng(seed), budget(searchBudget) {
+}
+
+// Change the search limits
+void MctsPolicy::setBudget(const MctsBudget& newBudget) {
+    budget = newBudget;
+}
+
+// Get statistics of the most recent decision
+const MctsStats& MctsPolicy::getLastStats() const {
+    return stats;
+}
+
+// Pick the most visited root action over all threads
+BattleDecision MctsPolicy::decide(const Battle& battle, BattleSide side) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(budget.timeLimitMs);
+    BattleModel model(battle);
+    BattleState root = model.initialState(side);
+
+    std::vector<int> actions;
+    model.legalActions(root, side, actions);
+    if (actions.size() <= 1) {
+        stats = MctsStats();
+        if (actions.empty()) {
+            // No move or switch is left, so give up the battle
+            BattleDecision decision;
+            decision.action = BattleAction::RUN;
+            return decision;
+        }
+        return BattleModel::toDecision(actions[0]);
+    }
+
+    int threadCount = budget.threads > 0 ? budget.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, threadCount);
+    bool timed = budget.timeLimitMs > 0 || budget.playouts <= 0;
+
+    std::atomic<long long> playouts(0);
+    std::vector<std::vector<int>> rootVisits(threadCount);
+    uint64_t searchSeed = rng();
+    std::shared_ptr<DataGeneration> data = DataGeneration::activeHandle();
+
+    auto worker = [&](int threadIndex) {
+        // Search on the data the battle was started with
+        GenerationPin pin(data);
+        SearchTree tree(model, root, side, budget, Rng::forStream(searchSeed, threadIndex)());
+        while (true) {
+            // Playouts are claimed from a shared counter so the count budget is exact
+            if (budget.playouts > 0 && playouts.fetch_add(1, std::memory_order_relaxed) >= budget.playouts) {
+                break;
+            }
+            tree.iterate();
+            if (budget.playouts <= 0) {
+                playouts.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (timed && std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+        }
+        for (const Edge& edge : tree.rootEdges()) {
+            rootVisits[threadIndex].push_back(edge.visits);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; i++) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every tree lists the root actions in the same order
+    int bestAction = actions[0];
+    long long bestVisits = -1;
+    for (size_t i = 0; i < actions.size(); ++i) {
+        long long visits = 0;
+        for (const auto& counts : rootVisits) {
+            visits += counts[i];
+        }
+        if (visits > bestVisits) {
+            bestVisits = visits;
+            bestAction = actions[i];
+        }
+    }
+
+    stats.playouts = budget.playouts > 0 ? std::min<long long>(playouts.load(), budget.playouts) : playouts.load();
+    stats.threads = threadCount;
+    stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return BattleModel::toDecision(bestAction);
+}
\ No newline at end of file
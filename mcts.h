@@ -0,0 +1,66 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <vector>
+#include "battle_policy.h"
+#include "battle_model.h"
+
+/**
+ * @brief How much work the MCTS policy may do per decision
+ */
+struct MctsBudget {
+    int playouts = 0;           // Total playouts across all threads (0 = limited by time only)
+    int timeLimitMs = 50;       // Wall-clock limit per decision (0 = limited by playouts only)
+    int threads = 0;            // Search threads (0 = one per hardware thread)
+    int rolloutSteps = 8;       // Steps simulated after leaving the tree before evaluating (short playouts are less noisy)
+    float exploration = 0.3f;   // UCT exploration constant (values lie in [-1, 1])
+    int maxNodes = 50000;       // Tree nodes per thread; once reached, new leaves are played out without being stored
+};
+
+/**
+ * @brief Statistics of the most recent search
+ */
+struct MctsStats {
+    long long playouts = 0;     // Playouts across all threads
+    int threads = 0;
+    double elapsedMs = 0.0;
+};
+
+/**
+ * @brief Policy that picks actions with Monte Carlo Tree Search over the battle model
+ *
+ * Chance events (status checks, hits, critical hits, damage and status procs)
+ * are sampled on every descent; each distinct outcome sequence after an
+ * action leads to its own child node. Search is root parallel: every thread
+ * grows a private tree and the root visit counts are summed at the end.
+ */
+class MctsPolicy : public DecisionPolicy {
+public:
+    /**
+     * @brief Constructor for MctsPolicy
+     * @param seed Seed for the playouts
+     * @param budget Playout, time and thread limits per decision
+     */
+    explicit MctsPolicy(uint64_t seed, const MctsBudget& budget = MctsBudget());
+
+    BattleDecision decide(const Battle& battle, BattleSide side) override;
+
+    /**
+     * @brief Change the search limits
+     * @param budget New playout, time and thread limits
+     */
+    void setBudget(const MctsBudget& budget);
+
+    /**
+     * @brief Get statistics of the most recent decision
+     * @return The search statistics
+     */
+    const MctsStats& getLastStats() const;
+
+private:
+    Rng rng;
+    MctsBudget budget;
+    MctsStats stats;
+};
+
+#endif // MCTS_H
\ No newline at end of file
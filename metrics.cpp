@@ -0,0 +1,303 @@
+#include "metrics.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <mutex>
+#include <algorithm>
+#include <iostream>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace {
+
+// How often the server checks if it should stop
+constexpr int POLL_MS = 250;
+
+// How long a client gets to send its request
+constexpr int REQUEST_TIMEOUT_MS = 1000;
+
+#ifndef _WIN32
+// A client that hangs up mid-response must not raise SIGPIPE and kill the game
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;   // No MSG_NOSIGNAL (macOS): the socket gets SO_NOSIGPIPE instead
+#endif
+#endif
+
+struct MetricInfo {
+    const char* name;
+    const char* help;
+    bool timed;
+};
+
+// Indexed by Metric
+const MetricInfo METRIC_INFO[METRIC_COUNT] = {
+    {"battle_turn", "Turns of the battle loop", true},
+    {"policy_decision", "Decisions made by players and AI", true},
+    {"use_move", "Moves used in battle", true},
+    {"calculate_damage", "Damage calculations", true},
+    {"check_status", "Status effect checks before a move", true},
+    {"first_alive", "Lookups of a team's first Pokemon able to battle", false},
+    {"event_flush", "Batches of battle events handed to sinks", true},
+    {"load_pokemon", "Loads of the Pokemon data file", true},
+    {"load_moves", "Loads of the move data file", true},
+    {"load_items", "Loads of the item data file", true},
+};
+
+// Every thread's block, plus the totals of threads that finished
+struct Registry {
+    std::mutex mutex;
+    std::vector<const void*> blocks;
+    std::array<uint64_t, METRIC_COUNT> retiredCalls = {};
+    std::array<uint64_t, METRIC_COUNT> retiredNanoseconds = {};
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Format nanoseconds as seconds
+std::string seconds(uint64_t nanoseconds) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(9) << static_cast<double>(nanoseconds) / 1e9;
+    return text.str();
+}
+
+} // namespace
+
+std::atomic<bool> Metrics::timing(false);
+
+// Turn timing on or off
+void Metrics::setTiming(bool enabled) {
+    timing.store(enabled, std::memory_order_relaxed);
+}
+
+// Give the calling thread its block; it is folded into the totals when the thread ends
+Metrics::Block* Metrics::attachThread() {
+    struct Owner {
+        Block* owned = new Block();
+
+        Owner() {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.blocks.push_back(owned);
+        }
+
+        ~Owner() {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            for (size_t i = 0; i < METRIC_COUNT; ++i) {
+                reg.retiredCalls[i] += owned->slots[i].calls.load(std::memory_order_relaxed);
+                reg.retiredNanoseconds[i] += owned->slots[i].nanoseconds.load(std::memory_order_relaxed);
+            }
+            reg.blocks.erase(std::find(reg.blocks.begin(), reg.blocks.end(), owned));
+            block = nullptr;
+            delete owned;
+        }
+    };
+    thread_local Owner owner;
+    block = owner.owned;
+    return block;
+}
+
+// Get the totals of every metric
+std::vector<MetricSample> Metrics::snapshot() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::vector<MetricSample> samples;
+    samples.reserve(METRIC_COUNT);
+    for (size_t i = 0; i < METRIC_COUNT; ++i) {
+        MetricSample sample;
+        sample.metric = static_cast<Metric>(i);
+        sample.name = METRIC_INFO[i].name;
+        sample.help = METRIC_INFO[i].help;
+        sample.timed = METRIC_INFO[i].timed;
+        sample.calls = reg.retiredCalls[i];
+        sample.nanoseconds = reg.retiredNanoseconds[i];
+        for (const void* entry : reg.blocks) {
+            const Block* threadMetrics = static_cast<const Block*>(entry);
+            sample.calls += threadMetrics->slots[i].calls.load(std::memory_order_relaxed);
+            sample.nanoseconds += threadMetrics->slots[i].nanoseconds.load(std::memory_order_relaxed);
+        }
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+// Format a snapshot of the metrics
+std::string Metrics::format(MetricsFormat format) {
+    std::vector<MetricSample> samples = snapshot();
+    std::string text;
+
+    if (format == MetricsFormat::JSON) {
+        text += "{\n  \"timing\": ";
+        text += isTiming() ? "true" : "false";
+        text += ",\n  \"metrics\": {\n";
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const MetricSample& sample = samples[i];
+            text += "    \"";
+            text += sample.name;
+            text += "\": {\"calls\": ";
+            text += std::to_string(sample.calls);
+            if (sample.timed) {
+                text += ", \"seconds\": ";
+                text += seconds(sample.nanoseconds);
+            }
+            text += i + 1 < samples.size() ? "},\n" : "}\n";
+        }
+        text += "  }\n}\n";
+        return text;
+    }
+
+    for (const MetricSample& sample : samples) {
+        std::string name = std::string("pokemon_") + sample.name;
+        text += "# HELP " + name + "_calls_total " + sample.help + "\n";
+        text += "# TYPE " + name + "_calls_total counter\n";
+        text += name + "_calls_total " + std::to_string(sample.calls) + "\n";
+        if (sample.timed) {
+            text += "# HELP " + name + "_seconds_total " + sample.help + ", time spent while timing was on\n";
+            text += "# TYPE " + name + "_seconds_total counter\n";
+            text += name + "_seconds_total " + seconds(sample.nanoseconds) + "\n";
+        }
+    }
+    return text;
+}
+
+// Write a snapshot of the metrics to a file
+bool Metrics::writeToFile(const std::string& filename, MetricsFormat format) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string text = Metrics::format(format);
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(file);
+}
+
+// Constructor
+MetricsServer::MetricsServer(int port) : listenFd(-1), stopping(false) {
+#ifndef _WIN32
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Can't serve metrics: no socket" << std::endl;
+        return;
+    }
+    // Not inherited by child processes (SOCK_CLOEXEC would do this atomically, but only on Linux)
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, 8) < 0) {
+        std::cerr << "Can't serve metrics on port " << port << std::endl;
+        close(fd);
+        return;
+    }
+    listenFd = fd;
+    worker = std::thread(&MetricsServer::run, this);
+#else
+    (void)port;
+#endif
+}
+
+// Destructor
+MetricsServer::~MetricsServer() {
+    stopping = true;
+    if (worker.joinable()) {
+        worker.join();
+    }
+#ifndef _WIN32
+    if (listenFd >= 0) {
+        close(listenFd);
+    }
+#endif
+}
+
+// Accept connections until stopped
+void MetricsServer::run() {
+#ifndef _WIN32
+    while (!stopping) {
+        pollfd ready = {listenFd, POLLIN, 0};
+        if (poll(&ready, 1, POLL_MS) <= 0) {
+            continue;
+        }
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            continue;
+        }
+        fcntl(clientFd, F_SETFD, FD_CLOEXEC);
+        answer(clientFd);
+        close(clientFd);
+    }
+#endif
+}
+
+// Answer one HTTP request
+void MetricsServer::answer(int clientFd) {
+#ifndef _WIN32
+    // Only the request line matters
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n") == std::string::npos && request.size() < 4096) {
+        pollfd readable = {clientFd, POLLIN, 0};
+        if (poll(&readable, 1, REQUEST_TIMEOUT_MS) <= 0) {
+            return;
+        }
+        ssize_t received = read(clientFd, buffer, sizeof(buffer));
+        if (received <= 0) {
+            return;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    std::string status = "200 OK";
+    std::string contentType;
+    std::string body;
+    if (request.compare(0, 18, "GET /metrics.json ") == 0) {
+        contentType = "application/json";
+        body = Metrics::format(MetricsFormat::JSON);
+    } else if (request.compare(0, 13, "GET /metrics ") == 0) {
+        contentType = "text/plain; version=0.0.4";
+        body = Metrics::format(MetricsFormat::PROMETHEUS);
+    } else {
+        status = "404 Not Found";
+        contentType = "text/plain";
+        body = "Try /metrics or /metrics.json\n";
+    }
+
+    std::string response = "HTTP/1.0 " + status + "\r\nContent-Type: " + contentType +
+                           "\r\nContent-Length: " + std::to_string(body.size()) +
+                           "\r\nConnection: close\r\n\r\n" + body;
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    int noSigpipe = 1;
+    setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigpipe, sizeof(noSigpipe));
+#endif
+    size_t written = 0;
+    while (written < response.size()) {
+        ssize_t count = send(clientFd, response.data() + written, response.size() - written, SEND_FLAGS);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return;
+        }
+        written += static_cast<size_t>(count);
+    }
+#else
+    (void)clientFd;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Instrumented parts of the game
+ */
+enum class Metric : uint8_t {
+    BATTLE_TURN,        // One turn of Battle::start's loop
+    POLICY_DECISION,    // A side deciding what to do (the AI or the player)
+    USE_MOVE,
+    CALCULATE_DAMAGE,
+    CHECK_STATUS,       // Battle::checkStatusEffects
+    FIRST_ALIVE,        // Team::getFirstAliveIndex (counted, never timed)
+    EVENT_FLUSH,        // Handing battle events to their sinks (text, logs, statistics)
+    LOAD_POKEMON,       // DataLoader::loadPokemon
+    LOAD_MOVES,         // DataLoader::loadMoves
+    LOAD_ITEMS,         // DataLoader::loadItems
+    COUNT
+};
+
+constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::COUNT);
+
+/**
+ * @brief Formats metrics can be exported in
+ */
+enum class MetricsFormat {
+    JSON,
+    PROMETHEUS      // Prometheus text exposition format
+};
+
+/**
+ * @brief Totals of one metric
+ */
+struct MetricSample {
+    Metric metric;
+    const char* name;           // snake_case, as exported
+    const char* help;
+    bool timed;                 // False for metrics that are only counted
+    uint64_t calls;
+    uint64_t nanoseconds;       // Only covers calls made while timing was on
+};
+
+/**
+ * @brief Process-wide counters and timers of the hot paths
+ *
+ * Always compiled in. Each thread counts into its own cache-line aligned
+ * block with plain relaxed stores, so instrumented code never contends;
+ * snapshots add the blocks up. Calls are always counted, which costs about
+ * as much as an increment. Reading the clock costs more than some of the
+ * timed functions, so timing is off until setTiming(true).
+ */
+class Metrics {
+public:
+    /**
+     * @brief Turn timing on or off (calls are counted either way)
+     * @param enabled True to time the instrumented code
+     */
+    static void setTiming(bool enabled);
+
+    /**
+     * @brief Check if timing is on
+     * @return True if instrumented code is timed
+     */
+    static bool isTiming() { return timing.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Count a call
+     * @param metric The metric
+     */
+    static void count(Metric metric) {
+        Slot& slot = threadBlock()->slots[static_cast<size_t>(metric)];
+        slot.calls.store(slot.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Count a timed call
+     * @param metric The metric
+     * @param nanoseconds Time the call took
+     */
+    static void record(Metric metric, uint64_t nanoseconds) {
+        Slot& slot = threadBlock()->slots[static_cast<size_t>(metric)];
+        slot.calls.store(slot.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        slot.nanoseconds.store(slot.nanoseconds.load(std::memory_order_relaxed) + nanoseconds,
+                               std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the totals of every metric, over all threads (including finished ones)
+     * @return One sample per metric, in Metric order
+     */
+    static std::vector<MetricSample> snapshot();
+
+    /**
+     * @brief Format a snapshot of the metrics
+     * @param format The format
+     * @return The text
+     */
+    static std::string format(MetricsFormat format);
+
+    /**
+     * @brief Write a snapshot of the metrics to a file
+     * @param filename The file (replaced)
+     * @param format The format
+     * @return True if the file was written
+     */
+    static bool writeToFile(const std::string& filename, MetricsFormat format);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> nanoseconds{0};
+    };
+
+    struct alignas(64) Block {
+        std::array<Slot, METRIC_COUNT> slots;
+    };
+
+    static std::atomic<bool> timing;
+    static inline thread_local Block* block = nullptr;     // Constant-initialized, so access needs no TLS wrapper
+
+    static Block* threadBlock() { return block ? block : attachThread(); }
+    static Block* attachThread();
+};
+
+/**
+ * @brief Counts (and, while timing is on, times) the scope it lives in
+ */
+class ScopedTimer {
+public:
+    /**
+     * @brief Start the timer
+     * @param timedMetric The metric the scope counts towards
+     */
+    explicit ScopedTimer(Metric timedMetric)
+        : metric(timedMetric), start(Metrics::isTiming() ? std::chrono::steady_clock::now()
+                                                         : std::chrono::steady_clock::time_point()) {}
+
+    /**
+     * @brief Stop the timer and record the call
+     */
+    ~ScopedTimer() {
+        if (start == std::chrono::steady_clock::time_point()) {
+            Metrics::count(metric);
+            return;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Metrics::record(metric, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Metric metric;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @brief Serves metrics over HTTP on a local TCP port, for Prometheus or curl
+ *
+ * GET /metrics answers in the Prometheus text format and GET /metrics.json
+ * in JSON. Only listens on 127.0.0.1. Does nothing on Windows.
+ */
+class MetricsServer {
+public:
+    /**
+     * @brief Start serving
+     * @param port Port to listen on
+     */
+    explicit MetricsServer(int port);
+
+    /**
+     * @brief Stop serving
+     */
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /**
+     * @brief Check if the server is listening
+     * @return False if the port couldn't be opened
+     */
+    bool isServing() const { return listenFd >= 0; }
+
+private:
+    int listenFd;
+    std::atomic<bool> stopping;
+    std::thread worker;
+
+    void run();
+    void answer(int clientFd);
+};
+
+#endif // METRICS_H
\ No newline at end of file
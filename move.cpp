@@ -1,14 +1,35 @@
 #include "move.h"
-#include <random>
+#include <unordered_map>
+
+// Convert a move category name from the data files to a category
+MoveCategory stringToCategory(const std::string& categoryStr) {
+    static const std::unordered_map<std::string, MoveCategory> stringMap = {
+        {"Physical", MoveCategory::PHYSICAL},
+        {"Special", MoveCategory::SPECIAL},
+        {"Status", MoveCategory::STATUS}
+    };
+    
+    auto it = stringMap.find(categoryStr);
+    return (it != stringMap.end()) ? it->second : MoveCategory::STATUS;
+}
 
 // Basic move constructor
 Move::Move(const std::string& n, int p, int a, PokemonType t)
-    : name(n), power(p), accuracy(a), type(t), statusEffect(StatusEffect::NONE), statusChance(0) {
+    : name(n), power(p), accuracy(a), type(t),
+      category(p > 0 ? MoveCategory::PHYSICAL : MoveCategory::STATUS), pp(DEFAULT_PP),
+      statusEffect(StatusEffect::NONE), statusChance(0) {
 }
 
 // Move constructor with status effect
 Move::Move(const std::string& n, int p, int a, PokemonType t, StatusEffect s, int c)
-    : name(n), power(p), accuracy(a), type(t), statusEffect(s), statusChance(c) {
+    : name(n), power(p), accuracy(a), type(t),
+      category(p > 0 ? MoveCategory::PHYSICAL : MoveCategory::STATUS), pp(DEFAULT_PP),
+      statusEffect(s), statusChance(c) {
+}
+
+// Move constructor with every property
+Move::Move(const std::string& n, PokemonType t, MoveCategory cat, int p, int a, int powerPoints, StatusEffect s, int c)
+    : name(n), power(p), accuracy(a), type(t), category(cat), pp(powerPoints), statusEffect(s), statusChance(c) {
 }
 
 // Check if move has a status effect
@@ -17,14 +38,10 @@ bool Move::hasStatusEffect() const {
 }
 
 // Check if status effect should be applied
-bool Move::shouldApplyStatus() const {
+bool Move::shouldApplyStatus(Rng& rng) const {
     if (!hasStatusEffect()) {
         return false;
     }
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, 100);
-    
-    return dis(gen) <= statusChance;
+    return rng.rollPercent(statusChance);
 }
\ No newline at end of file
@@ -4,6 +4,23 @@
 #include <string>
 #include "types.h"
 #include "status.h"
+#include "rng.h"
+
+/**
+ * @brief Enum representing the damage category of a move
+ */
+enum class MoveCategory {
+    PHYSICAL,
+    SPECIAL,
+    STATUS
+};
+
+/**
+ * @brief Converts a move category name from the data files to an enum value
+ * @param categoryStr The category name ("Physical", "Special" or "Status")
+ * @return The category (STATUS if not recognised)
+ */
+MoveCategory stringToCategory(const std::string& categoryStr);
 
 /**
  * @brief Class representing a Pokemon move
@@ -30,11 +47,28 @@ public:
      */
     Move(const std::string& n, int p, int a, PokemonType t, StatusEffect s, int c);
     
+    /**
+     * @brief Constructor for Move with every property (same order as moves.csv)
+     * @param n Name of the move
+     * @param t Type of the move
+     * @param cat Damage category of the move
+     * @param p Power of the move (0 for status moves)
+     * @param a Accuracy of the move (0-100)
+     * @param powerPoints Power points of the move
+     * @param s Status effect the move can cause
+     * @param c Chance of causing status effect (0-100)
+     */
+    Move(const std::string& n, PokemonType t, MoveCategory cat, int p, int a, int powerPoints, StatusEffect s, int c);
+    
+    static constexpr int DEFAULT_PP = 35;
+    
     // Basic move properties
     std::string name;
     int power;
     int accuracy;
     PokemonType type;
+    MoveCategory category;
+    int pp;
     
     // Status effect properties
     StatusEffect statusEffect;
@@ -48,9 +82,10 @@ public:
     
     /**
      * @brief Checks if status effect should be applied
+     * @param rng The battle's random number generator
      * @return True if the status should be applied based on chance
      */
-    bool shouldApplyStatus() const;
+    bool shouldApplyStatus(Rng& rng) const;
 };
 
 #endif // MOVE_H
\ No newline at end of file
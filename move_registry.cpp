@@ -0,0 +1,123 @@
+#include "move_registry.h"
+#include "data_loader.h"
+#include "data_generation.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Get the registry of the calling thread's data generation
+MoveRegistry& MoveRegistry::instance() {
+    return DataGeneration::active().moves;
+}
+
+// Constructor: the confusion self-hit always has ID 0
+MoveRegistry::MoveRegistry() {
+    add(Move("Confusion Damage", PokemonType::NORMAL, MoveCategory::PHYSICAL, 40, 100, 0, StatusEffect::NONE, 0));
+}
+
+// Copy a registry, keeping every ID
+MoveRegistry::MoveRegistry(const MoveRegistry& other) {
+    std::lock_guard<std::mutex> lock(other.mutex);
+    names = other.names;
+    types = other.types;
+    categories = other.categories;
+    powers = other.powers;
+    accuracies = other.accuracies;
+    pps = other.pps;
+    statusEffects = other.statusEffects;
+    statusChances = other.statusChances;
+    byName = other.byName;
+}
+
+// Register a move, or find it if it is already known
+MoveId MoveRegistry::add(const Move& move) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byName.find(move.name);
+    if (it != byName.end()) {
+        return it->second;
+    }
+    if (sealed) {
+        throw std::runtime_error("Cannot register the move " + move.name + ": its data generation is published");
+    }
+    if (names.size() >= INVALID_MOVE_ID) {
+        return INVALID_MOVE_ID;
+    }
+    
+    MoveId id = static_cast<MoveId>(names.size());
+    names.push_back(move.name);
+    types.emplace_back();
+    categories.emplace_back();
+    powers.emplace_back();
+    accuracies.emplace_back();
+    pps.emplace_back();
+    statusEffects.emplace_back();
+    statusChances.emplace_back();
+    store(id, move);
+    byName.emplace(move.name, id);
+    return id;
+}
+
+// Register a move, overwriting a known move's properties
+MoveId MoveRegistry::set(const Move& move) {
+    MoveId id = add(move);
+    if (id != INVALID_MOVE_ID) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (sealed) {
+            throw std::runtime_error("Cannot change the move " + move.name + ": its data generation is published");
+        }
+        store(id, move);
+    }
+    return id;
+}
+
+// Refuse every later change
+void MoveRegistry::seal() {
+    std::lock_guard<std::mutex> lock(mutex);
+    sealed = true;
+}
+
+// Write a move's properties into the columns
+void MoveRegistry::store(MoveId id, const Move& move) {
+    types[id] = move.type;
+    categories[id] = move.category;
+    powers[id] = static_cast<int16_t>(move.power);
+    accuracies[id] = static_cast<uint8_t>(std::min(std::max(move.accuracy, 0), 255));
+    pps[id] = static_cast<uint8_t>(std::min(std::max(move.pp, 0), 255));
+    statusEffects[id] = move.statusEffect;
+    statusChances[id] = static_cast<uint8_t>(std::min(std::max(move.statusChance, 0), 100));
+}
+
+// Register every move of a moves.csv file
+size_t MoveRegistry::loadFromFile(const std::string& filename) {
+    std::vector<Move> moves = DataLoader::loadMoves(filename);
+    for (const Move& move : moves) {
+        set(move);
+    }
+    return moves.size();
+}
+
+// Look up a move by name
+MoveId MoveRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byName.find(name);
+    return it != byName.end() ? it->second : INVALID_MOVE_ID;
+}
+
+// Get the number of registered moves
+size_t MoveRegistry::size() const {
+    return names.size();
+}
+
+// Rebuild a full Move from the table
+Move MoveRegistry::toMove(MoveId id) const {
+    return Move(names[id], types[id], categories[id], powers[id], accuracies[id], pps[id],
+                statusEffects[id], statusChances[id]);
+}
+
+// Check if a move's status effect should be applied
+bool MoveRegistry::shouldApplyStatus(MoveId id, Rng& rng) const {
+    if (!hasStatusEffect(id)) {
+        return false;
+    }
+    
+    return rng.rollPercent(statusChances[id]);
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef MOVE_REGISTRY_H
+#define MOVE_REGISTRY_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include "move.h"
+#include "types.h"
+#include "status.h"
+#include "rng.h"
+
+/**
+ * @brief Compact handle of a move in the move registry
+ */
+using MoveId = uint16_t;
+
+constexpr MoveId INVALID_MOVE_ID = 0xFFFF;
+
+/**
+ * @brief The typeless 40 power physical hit a confused Pokemon deals itself (always registered first)
+ */
+constexpr MoveId CONFUSION_MOVE_ID = 0;
+
+/**
+ * @brief Global table of every known move, interned by name
+ *
+ * Properties are kept as parallel arrays (struct of arrays), so resolving a
+ * MoveId during damage calculation touches only the fields it reads. Each
+ * DataGeneration owns one registry; moves are registered while a generation
+ * is loaded, and publishing it seals the registry against further changes. IDs carry over from one
+ * generation to the next, so a Pokemon stays valid across a reload.
+ */
+class MoveRegistry {
+public:
+    /**
+     * @brief Constructor for an empty registry (only the confusion self-hit is registered)
+     */
+    MoveRegistry();
+    
+    /**
+     * @brief Copy a registry, keeping every ID (used to start the next data generation)
+     * @param other The registry to copy
+     */
+    MoveRegistry(const MoveRegistry& other);
+    MoveRegistry& operator=(const MoveRegistry&) = delete;
+    
+    /**
+     * @brief Get the registry of the calling thread's data generation
+     * @return The registry
+     */
+    static MoveRegistry& instance();
+
+    /**
+     * @brief Register a move, or find it if a move with the same name exists
+     * @param move The move to register
+     * @return The move's ID
+     * @throws std::runtime_error if the move is new and the registry is sealed
+     */
+    MoveId add(const Move& move);
+
+    /**
+     * @brief Register a move, overwriting the properties of a move with the same name
+     * @param move The move to register
+     * @return The move's ID (unchanged for a known name)
+     * @throws std::runtime_error if the registry is sealed
+     */
+    MoveId set(const Move& move);
+
+    /**
+     * @brief Register every move of a moves.csv file, updating moves already known by name
+     * @param filename The file to load from
+     * @return Number of moves read
+     */
+    size_t loadFromFile(const std::string& filename);
+
+    /**
+     * @brief Refuse every later change (called when the registry's data generation is published)
+     */
+    void seal();
+
+    /**
+     * @brief Look up a move by name
+     * @param name The move's name
+     * @return The move's ID, or INVALID_MOVE_ID if it isn't registered
+     */
+    MoveId find(const std::string& name) const;
+
+    /**
+     * @brief Get the number of registered moves
+     * @return Move count
+     */
+    size_t size() const;
+
+    /**
+     * @brief Rebuild a full Move from the table
+     * @param id The move's ID
+     * @return The move
+     */
+    Move toMove(MoveId id) const;
+
+    // Property lookups (id must be valid)
+    const std::string& getName(MoveId id) const { return names[id]; }
+    PokemonType getType(MoveId id) const { return types[id]; }
+    MoveCategory getCategory(MoveId id) const { return categories[id]; }
+    int getPower(MoveId id) const { return powers[id]; }
+    int getAccuracy(MoveId id) const { return accuracies[id]; }
+    int getPp(MoveId id) const { return pps[id]; }
+    StatusEffect getStatusEffect(MoveId id) const { return statusEffects[id]; }
+    int getStatusChance(MoveId id) const { return statusChances[id]; }
+
+    /**
+     * @brief Checks if a move has a status effect
+     * @param id The move's ID
+     * @return True if the move can cause a status effect
+     */
+    bool hasStatusEffect(MoveId id) const {
+        return statusEffects[id] != StatusEffect::NONE && statusChances[id] > 0;
+    }
+
+    /**
+     * @brief Checks if a move's status effect should be applied
+     * @param id The move's ID
+     * @param rng The battle's random number generator
+     * @return True if the status should be applied based on chance
+     */
+    bool shouldApplyStatus(MoveId id, Rng& rng) const;
+
+private:
+    std::vector<std::string> names;
+    std::vector<PokemonType> types;
+    std::vector<MoveCategory> categories;
+    std::vector<int16_t> powers;
+    std::vector<uint8_t> accuracies;
+    std::vector<uint8_t> pps;
+    std::vector<StatusEffect> statusEffects;
+    std::vector<uint8_t> statusChances;
+    std::unordered_map<std::string, MoveId> byName;
+    bool sealed = false;        // Set once the generation is published; copies start unsealed
+    mutable std::mutex mutex;   // Guards registration only
+
+    void store(MoveId id, const Move& move);
+};
+
+/**
+ * @brief Shorthand for the move registry of the calling thread's data generation
+ * @return The registry
+ */
+inline MoveRegistry& moveRegistry() {
+    return MoveRegistry::instance();
+}
+
+#endif // MOVE_REGISTRY_H
\ No newline at end of file
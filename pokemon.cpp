@@ -4,33 +4,106 @@
 #include <sstream>
 #include <cmath>
 
+namespace {
+
+// Register a species from the stats of a newly built Pokemon
+SpeciesId registerSpecies(const std::string& n, int h, int a, int d, int s, int sd, int spd,
+                          PokemonType t1, PokemonType t2) {
+    Species entry;
+    entry.name = n;
+    entry.baseHp = h;
+    entry.baseAttack = a;
+    entry.baseDefense = d;
+    entry.baseSpecialAttack = s;
+    entry.baseSpecialDefense = sd;
+    entry.baseSpeed = spd;
+    entry.primaryType = t1;
+    entry.secondaryType = t2;
+    return SpeciesRegistry::instance().add(entry);
+}
+
+} // namespace
+
 // Constructor
 Pokemon::Pokemon(const std::string& n, int h, int a, int d, int s, int sd, int spd,
                  PokemonType t1, PokemonType t2)
-    : name(n), hp(h), maxHp(h), attack(a), defense(d), specialAttack(s), specialDefense(sd),
-      speed(spd), level(5), experience(0), primaryType(t1), secondaryType(t2), status(StatusEffect::NONE),
-      evolutionForm(""), evolutionLevel(0) {
+    : Pokemon(registerSpecies(n, h, a, d, s, sd, spd, t1, t2)) {
+    
+    // The given stats win over those of an already registered species with the same name
+    hp = maxHp = h;
+    attack = a;
+    defense = d;
+    specialAttack = s;
+    specialDefense = sd;
+    speed = spd;
+}
+
+// Constructor from a registered species
+Pokemon::Pokemon(SpeciesId speciesId)
+    : species(speciesId), level(5), experience(0), status(StatusEffect::NONE), moveCount(0) {
+    const Species& entry = getSpecies();
+    defensiveProfile = entry.defensiveProfile;
+    hp = maxHp = entry.baseHp;
+    attack = entry.baseAttack;
+    defense = entry.baseDefense;
+    specialAttack = entry.baseSpecialAttack;
+    specialDefense = entry.baseSpecialDefense;
+    speed = entry.baseSpeed;
+    
+    // No moves yet
+    moveIds.fill(INVALID_MOVE_ID);
+    movePp.fill(0);
     
     // Initialize stat modifiers
-    statModifiers["attack"] = 0;
-    statModifiers["defense"] = 0;
-    statModifiers["specialAttack"] = 0;
-    statModifiers["specialDefense"] = 0;
-    statModifiers["speed"] = 0;
-    statModifiers["accuracy"] = 0;
-    statModifiers["evasion"] = 0;
+    statModifiers.fill(0);
     
     // Calculate experience needed for next level
     experienceToNextLevel = calculateExpToNextLevel();
 }
 
-// Add a move to the Pokemon
+// Add a move to the Pokemon, registering it if it is new
 void Pokemon::addMove(const Move& move) {
-    if (moves.size() < 4) {
-        moves.push_back(move);
+    addMove(MoveRegistry::instance().add(move));
+}
+
+// Add a registered move to the Pokemon
+void Pokemon::addMove(MoveId id) {
+    if (id == INVALID_MOVE_ID) {
+        return;
+    }
+    if (moveCount < MAX_MOVES) {
+        moveIds[moveCount] = id;
+        movePp[moveCount] = static_cast<uint8_t>(MoveRegistry::instance().getPp(id));
+        ++moveCount;
     } else {
         // Could add logic to replace a move
-        std::cout << name << " already knows 4 moves!" << std::endl;
+        std::cout << getName() << " already knows 4 moves!" << std::endl;
+    }
+}
+
+// Spend one PP of a known move
+bool Pokemon::spendPp(int index) {
+    if (movePp[index] == 0) {
+        return false;
+    }
+    --movePp[index];
+    return true;
+}
+
+// Check if any known move has PP left
+bool Pokemon::hasPpLeft() const {
+    for (int i = 0; i < moveCount; ++i) {
+        if (movePp[i] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Restore the PP of every known move
+void Pokemon::restorePp() {
+    for (int i = 0; i < moveCount; ++i) {
+        movePp[i] = static_cast<uint8_t>(MoveRegistry::instance().getPp(moveIds[i]));
     }
 }
 
@@ -51,20 +124,20 @@ std::string Pokemon::useItem(const Item& item) {
     if (item.isHealingItem()) {
         int oldHp = hp;
         hp = std::min(maxHp, hp + item.healAmount);
-        result << name << " recovered " << (hp - oldHp) << " HP!";
+        result << getName() << " recovered " << (hp - oldHp) << " HP!";
     } else if (item.isStatusHealItem()) {
         if (item.healStatus == StatusEffect::NONE || item.healStatus == status) {
-            result << name << " was cured of " << statusToString(status) << "!";
+            result << getName() << " was cured of " << statusToString(status) << "!";
             status = StatusEffect::NONE;
         } else {
             result << "It had no effect!";
         }
     } else if (item.isStatBoostItem()) {
         applyStatModifier(item.boostStat, item.boostAmount);
-        result << name << "'s " << item.boostStat << " rose!";
+        result << getName() << "'s " << statToString(item.boostStat) << " rose!";
     } else if (item.isReviveItem() && isDefeated()) {
         hp = maxHp / 2;
-        result << name << " was revived!";
+        result << getName() << " was revived!";
     } else {
         result << "The item had no effect!";
     }
@@ -76,55 +149,72 @@ std::string Pokemon::useItem(const Item& item) {
 std::string Pokemon::applyStatus(StatusEffect newStatus) {
     // If already has a status, new one doesn't apply
     if (status != StatusEffect::NONE) {
-        return name + " already has a status condition!";
+        return getName() + " already has a status condition!";
     }
     
     status = newStatus;
-    return name + " is now " + statusToString(status) + "!";
+    return getName() + " is now " + statusToString(status) + "!";
 }
 
 // Add experience points to the Pokemon
-bool Pokemon::addExperience(int exp) {
+bool Pokemon::addExperience(int exp, Rng& rng) {
     experience += exp;
     bool leveledUp = false;
     
     // Check for level up
     while (experience >= experienceToNextLevel) {
-        // Level up
-        level++;
-        leveledUp = true;
-        
-        // Increase stats (simplified for this example)
-        maxHp += 3 + (rand() % 3);
-        attack += 1 + (rand() % 2);
-        defense += 1 + (rand() % 2);
-        specialAttack += 1 + (rand() % 2);
-        specialDefense += 1 + (rand() % 2);
-        speed += 1 + (rand() % 2);
-        
         // Reduce experience by amount needed for this level
         experience -= experienceToNextLevel;
-        
-        // Calculate experience needed for next level
-        experienceToNextLevel = calculateExpToNextLevel();
+        gainLevel(rng);
+        leveledUp = true;
     }
     
     return leveledUp;
 }
 
+// Set the Pokemon's level, gaining the stats of every level on the way up
+void Pokemon::setLevel(int newLevel, Rng& rng) {
+    newLevel = std::max(1, std::min(newLevel, 100));
+    while (level < newLevel) {
+        gainLevel(rng);
+    }
+    level = newLevel;
+    experience = 0;
+    experienceToNextLevel = calculateExpToNextLevel();
+}
+
+// Go up one level
+void Pokemon::gainLevel(Rng& rng) {
+    level++;
+    
+    // Increase stats (simplified for this example)
+    maxHp += rng.uniformInt(3, 5);
+    attack += rng.uniformInt(1, 2);
+    defense += rng.uniformInt(1, 2);
+    specialAttack += rng.uniformInt(1, 2);
+    specialDefense += rng.uniformInt(1, 2);
+    speed += rng.uniformInt(1, 2);
+    
+    // Calculate experience needed for next level
+    experienceToNextLevel = calculateExpToNextLevel();
+}
+
 // Check if the Pokemon can evolve
 bool Pokemon::canEvolve() const {
-    return !evolutionForm.empty() && level >= evolutionLevel;
+    const Species& entry = getSpecies();
+    return entry.canEvolve() && level >= entry.evolutionLevel;
 }
 
 // Evolve the Pokemon
 std::string Pokemon::evolve() {
     if (!canEvolve()) {
-        return name + " cannot evolve yet!";
+        return getName() + " cannot evolve yet!";
     }
     
-    std::string oldName = name;
-    name = evolutionForm;
+    // Evolving only swaps the species; the stats gained so far are kept
+    std::string oldName = getName();
+    species = getSpecies().evolution;
+    defensiveProfile = getSpecies().defensiveProfile;
     
     // Boost stats for evolution
     maxHp += 20;
@@ -135,36 +225,39 @@ std::string Pokemon::evolve() {
     specialDefense += 10;
     speed += 10;
     
-    // Clear evolution info since it already evolved
-    evolutionForm = "";
-    evolutionLevel = 0;
-    
-    return oldName + " evolved into " + name + "!";
+    return oldName + " evolved into " + getName() + "!";
 }
 
 // Get a colored display of the Pokemon's name with type
 std::string Pokemon::getColoredDisplay() const {
-    std::stringstream ss;
+    return coloredDisplay(species, status);
+}
+
+// Get a colored display of a species' name with type and a status
+std::string coloredDisplay(SpeciesId species, StatusEffect status) {
+    const Species& entry = SpeciesRegistry::instance().get(species);
+    const char* reset = "\033[0m";
+    std::string primaryColor = getTypeColor(entry.primaryType);
     
     // Add colored name based on primary type
-    ss << getTypeColor(primaryType) << name << "\033[0m";
+    std::string text = primaryColor + entry.name + reset;
     
     // Add type information
-    ss << " [" << getTypeColor(primaryType) << typeToString(primaryType) << "\033[0m";
+    text += " [" + primaryColor + typeToString(entry.primaryType) + reset;
     
     // Add secondary type if it exists
-    if (secondaryType != PokemonType::NONE) {
-        ss << "/" << getTypeColor(secondaryType) << typeToString(secondaryType) << "\033[0m";
+    if (entry.secondaryType != PokemonType::NONE) {
+        text += "/" + getTypeColor(entry.secondaryType) + typeToString(entry.secondaryType) + reset;
     }
     
-    ss << "]";
+    text += "]";
     
     // Add status if present
     if (status != StatusEffect::NONE) {
-        ss << " " << getStatusColor(status) << statusToString(status) << "\033[0m";
+        text += " " + getStatusColor(status) + statusToString(status) + reset;
     }
     
-    return ss.str();
+    return text;
 }
 
 // Calculate experience needed for next level
@@ -174,12 +267,13 @@ int Pokemon::calculateExpToNextLevel() const {
 }
 
 // Apply a stat modifier
-void Pokemon::applyStatModifier(const std::string& stat, int stages) {
-    // Ensure stat exists in the map
-    if (statModifiers.find(stat) == statModifiers.end()) {
+void Pokemon::applyStatModifier(Stat stat, int stages) {
+    // Ignore stats that weren't recognised when the data was loaded
+    if (stat == Stat::NONE) {
         return;
     }
     
     // Apply the modifier (clamped between -6 and +6)
-    statModifiers[stat] = std::max(-6, std::min(6, statModifiers[stat] + stages));
+    int8_t& stage = statModifiers[static_cast<int>(stat)];
+    stage = static_cast<int8_t>(clampStatStage(stage + stages));
 }
\ No newline at end of file
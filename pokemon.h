@@ -3,19 +3,27 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <array>
+#include <cstdint>
 #include "move.h"
+#include "move_registry.h"
+#include "species.h"
 #include "types.h"
+#include "stats.h"
 #include "status.h"
 #include "item.h"
 
 /**
- * @brief Class representing a Pokemon
+ * @brief Class representing one Pokemon in a team
+ *
+ * Everything shared by a species (name, base stats, types, evolution) lives in
+ * the SpeciesRegistry; a Pokemon only holds its species ID and the state of
+ * this individual, so copying one is a plain struct copy.
  */
 class Pokemon {
 public:
     /**
-     * @brief Constructor for Pokemon
+     * @brief Constructor for Pokemon, registering its species if it is new
      * @param n Name of the Pokemon
      * @param h Hit points (HP)
      * @param a Attack stat
@@ -25,12 +33,24 @@ public:
      * @param spd Speed stat
      * @param t1 Primary type
      * @param t2 Secondary type (defaults to NONE)
+     * @throws std::runtime_error if the species is new and the thread's data generation is published
      */
     Pokemon(const std::string& n, int h, int a, int d, int s, int sd, int spd, 
             PokemonType t1, PokemonType t2 = PokemonType::NONE);
     
+    /**
+     * @brief Constructor for a Pokemon of a registered species, with the species' base stats
+     * @param speciesId The species' ID
+     */
+    explicit Pokemon(SpeciesId speciesId);
+    
+    static constexpr int MAX_MOVES = 4;
+    
+    // Shared species data
+    SpeciesId species;
+    const DefensiveProfile* defensiveProfile;   // Cached from the species for damage calculation
+    
     // Basic Pokemon properties
-    std::string name;
     int hp;
     int maxHp;
     int attack;
@@ -41,24 +61,91 @@ public:
     int level;
     int experience;
     int experienceToNextLevel;
-    PokemonType primaryType;
-    PokemonType secondaryType;
     StatusEffect status;
-    std::vector<Move> moves;
     
-    // Stat modifiers
-    std::map<std::string, int> statModifiers;
+    // Known moves as registry handles, with the PP left on each
+    std::array<MoveId, MAX_MOVES> moveIds;
+    std::array<uint8_t, MAX_MOVES> movePp;
+    uint8_t moveCount;
+    
+    // Stat modifiers (stages -6..+6, indexed by Stat)
+    std::array<int8_t, STAT_COUNT> statModifiers;
+    
+    /**
+     * @brief Get the Pokemon's species
+     * @return The shared species record
+     */
+    const Species& getSpecies() const;
+    
+    /**
+     * @brief Get the Pokemon's name
+     * @return The species name
+     */
+    const std::string& getName() const;
     
-    // Evolution information
-    std::string evolutionForm;
-    int evolutionLevel;
+    /**
+     * @brief Get the Pokemon's primary type
+     * @return The primary type
+     */
+    PokemonType getPrimaryType() const;
     
     /**
-     * @brief Add a move to the Pokemon
+     * @brief Get the Pokemon's secondary type
+     * @return The secondary type (NONE for single-typed)
+     */
+    PokemonType getSecondaryType() const;
+    
+    /**
+     * @brief Add a move to the Pokemon, registering it if it is new
      * @param move The move to add
+     * @throws std::runtime_error if the move is new and the thread's data generation is published
      */
     void addMove(const Move& move);
     
+    /**
+     * @brief Add a registered move to the Pokemon
+     * @param id The move's ID
+     */
+    void addMove(MoveId id);
+    
+    /**
+     * @brief Get the number of known moves
+     * @return Move count (0-4)
+     */
+    int getMoveCount() const;
+    
+    /**
+     * @brief Get a known move
+     * @param index Move slot (0 to getMoveCount() - 1)
+     * @return The move's ID
+     */
+    MoveId getMove(int index) const;
+    
+    /**
+     * @brief Get the PP left on a known move
+     * @param index Move slot
+     * @return Remaining PP
+     */
+    int getPp(int index) const;
+    
+    /**
+     * @brief Spend one PP of a known move
+     * @param index Move slot
+     * @return False if the move had no PP left
+     */
+    bool spendPp(int index);
+    
+    /**
+     * @brief Check if any known move has PP left
+     * @return True if at least one move can still be used normally
+     */
+    bool hasPpLeft() const;
+    
+    /**
+     * @brief Restore the PP of every known move
+     */
+    void restorePp();
+    
     /**
      * @brief Check if the Pokemon is defeated
      * @return True if the Pokemon's HP is 0 or less
@@ -87,9 +174,17 @@ public:
     /**
      * @brief Add experience points to the Pokemon
      * @param exp The amount of experience to add
+     * @param rng Random number generator for stat gains
      * @return True if the Pokemon leveled up
      */
-    bool addExperience(int exp);
+    bool addExperience(int exp, Rng& rng);
+    
+    /**
+     * @brief Set the Pokemon's level, gaining the stats of every level it goes up
+     * @param newLevel The level (1-100); lowering it keeps the current stats
+     * @param rng Random number generator for stat gains
+     */
+    void setLevel(int newLevel, Rng& rng);
     
     /**
      * @brief Check if the Pokemon can evolve
@@ -109,6 +204,20 @@ public:
      */
     std::string getColoredDisplay() const;
     
+    /**
+     * @brief Get the final type effectiveness of an attack against this Pokemon
+     * @param attackType The attacking move's type
+     * @return Combined multiplier for both of this Pokemon's types
+     */
+    float getTypeEffectiveness(PokemonType attackType) const;
+    
+    /**
+     * @brief Get the current stage of a stat
+     * @param stat The stat to look up
+     * @return Stage between -6 and +6
+     */
+    int getStatStage(Stat stat) const;
+    
 private:
     /**
      * @brief Calculate experience needed for next level
@@ -116,12 +225,62 @@ private:
      */
     int calculateExpToNextLevel() const;
     
+    /**
+     * @brief Go up one level and gain its stats
+     * @param rng Random number generator for stat gains
+     */
+    void gainLevel(Rng& rng);
+    
     /**
      * @brief Apply a stat modifier
      * @param stat The stat to modify
      * @param stages The number of stages to modify by
      */
-    void applyStatModifier(const std::string& stat, int stages);
+    void applyStatModifier(Stat stat, int stages);
 };
 
+inline float Pokemon::getTypeEffectiveness(PokemonType attackType) const {
+    return defensiveProfile->multipliers[static_cast<int>(attackType)];
+}
+
+inline const Species& Pokemon::getSpecies() const {
+    return SpeciesRegistry::instance().get(species);
+}
+
+inline const std::string& Pokemon::getName() const {
+    return getSpecies().name;
+}
+
+inline PokemonType Pokemon::getPrimaryType() const {
+    return getSpecies().primaryType;
+}
+
+inline PokemonType Pokemon::getSecondaryType() const {
+    return getSpecies().secondaryType;
+}
+
+inline int Pokemon::getMoveCount() const {
+    return moveCount;
+}
+
+inline MoveId Pokemon::getMove(int index) const {
+    return moveIds[index];
+}
+
+inline int Pokemon::getPp(int index) const {
+    return movePp[index];
+}
+
+inline int Pokemon::getStatStage(Stat stat) const {
+    return statModifiers[static_cast<int>(stat)];
+}
+
+/**
+ * @brief Get a colored display of a species' name with type, as shown in battle
+ * @param species The species
+ * @param status Status effect to show (NONE for none)
+ * @return Formatted string with ANSI color codes
+ */
+std::string coloredDisplay(SpeciesId species, StatusEffect status);
+
 #endif // POKEMON_H
\ No newline at end of file
@@ -1,43 +1,457 @@
 #include "record_log.h"
+#include "battle.h"
+#include "data_generation.h"
 #include <iostream>
 #include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+// Replay file layout: magic, version, then one varint-length-prefixed record per battle
+constexpr char REPLAY_MAGIC[8] = {'P', 'K', 'M', 'N', 'R', 'P', 'L', '\0'};
+// (version 2: teams store counted item stacks, and item decisions index stacks)
+constexpr uint32_t REPLAY_VERSION = 2;
+
+// Little-endian, varint-based encoder
+class ByteWriter {
+public:
+    std::string bytes;
+
+    void byte(uint8_t value) {
+        bytes += static_cast<char>(value);
+    }
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            byte(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        byte(static_cast<uint8_t>(value));
+    }
+
+    // Signed numbers are zigzag encoded so small negatives stay short
+    void integer(int64_t value) {
+        varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void fixed(uint64_t value, int byteCount) {
+        for (int i = 0; i < byteCount; ++i) {
+            byte(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void text(const std::string& value) {
+        varint(value.size());
+        bytes += value;
+    }
+};
+
+// Decoder matching ByteWriter; a read past the end or a malformed number clears ok
+class ByteReader {
+public:
+    ByteReader(const char* start, size_t length) : data(start), size(length), position(0), ok(true) {
+    }
+
+    uint8_t byte() {
+        if (position >= size) {
+            ok = false;
+            return 0;
+        }
+        return static_cast<uint8_t>(data[position++]);
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t next = byte();
+            value |= static_cast<uint64_t>(next & 0x7F) << shift;
+            if (!(next & 0x80)) {
+                return value;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    int64_t integer() {
+        uint64_t value = varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    uint64_t fixed(int byteCount) {
+        uint64_t value = 0;
+        for (int i = 0; i < byteCount; ++i) {
+            value |= static_cast<uint64_t>(byte()) << (8 * i);
+        }
+        return value;
+    }
+
+    std::string text() {
+        uint64_t length = varint();
+        if (length > size - position) {
+            ok = false;
+            return std::string();
+        }
+        std::string value(data + position, static_cast<size_t>(length));
+        position += static_cast<size_t>(length);
+        return value;
+    }
+
+    // Split off the next bytes as a reader of their own
+    ByteReader slice(uint64_t length) {
+        if (length > size - position) {
+            ok = false;
+            length = size - position;
+        }
+        ByteReader part(data + position, static_cast<size_t>(length));
+        position += static_cast<size_t>(length);
+        return part;
+    }
+
+    bool atEnd() const { return position == size; }
+    bool good() const { return ok; }
+
+private:
+    const char* data;
+    size_t size;
+    size_t position;
+    bool ok;
+};
+
+// Snapshot a team
+TeamRecord recordTeam(const Team& team) {
+    TeamRecord record;
+    for (const Pokemon& pokemon : team.getMembers()) {
+        PokemonRecord member;
+        member.species = pokemon.getName();
+        member.level = pokemon.level;
+        member.experience = pokemon.experience;
+        member.experienceToNextLevel = pokemon.experienceToNextLevel;
+        member.hp = pokemon.hp;
+        member.maxHp = pokemon.maxHp;
+        member.attack = pokemon.attack;
+        member.defense = pokemon.defense;
+        member.specialAttack = pokemon.specialAttack;
+        member.specialDefense = pokemon.specialDefense;
+        member.speed = pokemon.speed;
+        member.status = pokemon.status;
+        member.statModifiers = pokemon.statModifiers;
+        for (int i = 0; i < pokemon.getMoveCount(); ++i) {
+            member.moves.push_back(moveRegistry().getName(pokemon.getMove(i)));
+            member.pp.push_back(static_cast<uint8_t>(pokemon.getPp(i)));
+        }
+        record.members.push_back(member);
+    }
+    for (int i = 0; i < team.items.size(); ++i) {
+        record.items.push_back(team.items.getItem(i));
+        record.itemCounts.push_back(team.items.getCount(i));
+    }
+    return record;
+}
+
+// Rebuild a team from its snapshot
+Team restoreTeam(const TeamRecord& record) {
+    Team team;
+    for (const PokemonRecord& member : record.members) {
+        SpeciesId species = SpeciesRegistry::instance().find(member.species);
+        if (species == INVALID_SPECIES_ID) {
+            throw std::runtime_error("Replay refers to an unknown Pokemon: " + member.species);
+        }
+        Pokemon pokemon(species);
+        pokemon.level = member.level;
+        pokemon.experience = member.experience;
+        pokemon.experienceToNextLevel = member.experienceToNextLevel;
+        pokemon.hp = member.hp;
+        pokemon.maxHp = member.maxHp;
+        pokemon.attack = member.attack;
+        pokemon.defense = member.defense;
+        pokemon.specialAttack = member.specialAttack;
+        pokemon.specialDefense = member.specialDefense;
+        pokemon.speed = member.speed;
+        pokemon.status = member.status;
+        pokemon.statModifiers = member.statModifiers;
+        for (size_t i = 0; i < member.moves.size() && i < Pokemon::MAX_MOVES; ++i) {
+            MoveId move = moveRegistry().find(member.moves[i]);
+            if (move == INVALID_MOVE_ID) {
+                throw std::runtime_error("Replay refers to an unknown move: " + member.moves[i]);
+            }
+            pokemon.addMove(move);
+            pokemon.movePp[i] = member.pp[i];
+        }
+        team.addPokemon(pokemon);
+    }
+    for (size_t i = 0; i < record.items.size(); ++i) {
+        if (itemRegistry().find(record.items[i]) == INVALID_ITEM_ID) {
+            throw std::runtime_error("Replay refers to an unknown item: " + record.items[i].name);
+        }
+        team.addItem(record.items[i], record.itemCounts[i]);
+    }
+    return team;
+}
+
+// Write a decision: the action and its main index share one varint (indices below -1 act like -1)
+void writeDecision(ByteWriter& out, const BattleDecision& decision) {
+    uint64_t action = static_cast<uint64_t>(decision.action) - static_cast<uint64_t>(BattleAction::FIGHT);
+    auto index = [](int value) { return static_cast<uint64_t>(std::max(-1, value) + 1); };
+    switch (decision.action) {
+        case BattleAction::FIGHT:
+            out.varint(action | index(decision.moveIndex) << 2);
+            break;
+        case BattleAction::ITEM:
+            out.varint(action | index(decision.itemIndex) << 2);
+            out.varint(index(decision.pokemonIndex));
+            break;
+        case BattleAction::SWITCH:
+            out.varint(action | index(decision.pokemonIndex) << 2);
+            break;
+        case BattleAction::RUN:
+            out.varint(action);
+            break;
+    }
+}
+
+// Read a decision written by writeDecision
+BattleDecision readDecision(ByteReader& in) {
+    uint64_t code = in.varint();
+    int index = static_cast<int>(code >> 2) - 1;
+    BattleDecision decision;
+    decision.action = static_cast<BattleAction>(static_cast<int>(code & 3) + static_cast<int>(BattleAction::FIGHT));
+    switch (decision.action) {
+        case BattleAction::FIGHT:
+            decision.moveIndex = index;
+            break;
+        case BattleAction::ITEM:
+            decision.itemIndex = index;
+            decision.pokemonIndex = static_cast<int>(in.varint()) - 1;
+            break;
+        case BattleAction::SWITCH:
+            decision.pokemonIndex = index;
+            break;
+        case BattleAction::RUN:
+            break;
+    }
+    return decision;
+}
+
+// Write a team snapshot
+void writeTeam(ByteWriter& out, const TeamRecord& team) {
+    out.varint(team.members.size());
+    for (const PokemonRecord& member : team.members) {
+        out.text(member.species);
+        for (int value : {member.level, member.experience, member.experienceToNextLevel, member.hp, member.maxHp,
+                          member.attack, member.defense, member.specialAttack, member.specialDefense, member.speed}) {
+            out.integer(value);
+        }
+        out.byte(static_cast<uint8_t>(member.status));
+        for (int8_t stage : member.statModifiers) {
+            out.integer(stage);
+        }
+        out.varint(member.moves.size());
+        for (size_t i = 0; i < member.moves.size(); ++i) {
+            out.text(member.moves[i]);
+            out.byte(member.pp[i]);
+        }
+    }
+    out.varint(team.items.size());
+    for (size_t i = 0; i < team.items.size(); ++i) {
+        const Item& item = team.items[i];
+        out.varint(team.itemCounts[i]);
+        out.text(item.name);
+        out.byte(static_cast<uint8_t>(item.type));
+        out.integer(item.healAmount);
+        out.byte(static_cast<uint8_t>(item.healStatus));
+        out.byte(static_cast<uint8_t>(item.boostStat));
+        out.integer(item.boostAmount);
+    }
+}
+
+// Read a team snapshot written by writeTeam
+TeamRecord readTeam(ByteReader& in) {
+    TeamRecord team;
+    uint64_t memberCount = in.varint();
+    for (uint64_t i = 0; i < memberCount && in.good(); ++i) {
+        PokemonRecord member;
+        member.species = in.text();
+        for (int* value : {&member.level, &member.experience, &member.experienceToNextLevel, &member.hp,
+                           &member.maxHp, &member.attack, &member.defense, &member.specialAttack,
+                           &member.specialDefense, &member.speed}) {
+            *value = static_cast<int>(in.integer());
+        }
+        member.status = static_cast<StatusEffect>(in.byte());
+        for (int8_t& stage : member.statModifiers) {
+            stage = static_cast<int8_t>(in.integer());
+        }
+        uint64_t moveCount = in.varint();
+        for (uint64_t j = 0; j < moveCount && in.good(); ++j) {
+            member.moves.push_back(in.text());
+            member.pp.push_back(in.byte());
+        }
+        team.members.push_back(member);
+    }
+    uint64_t itemCount = in.varint();
+    for (uint64_t i = 0; i < itemCount && in.good(); ++i) {
+        team.itemCounts.push_back(static_cast<int>(in.varint()));
+        Item item(in.text(), 0);
+        item.type = static_cast<ItemType>(in.byte());
+        item.healAmount = static_cast<int>(in.integer());
+        item.healStatus = static_cast<StatusEffect>(in.byte());
+        item.boostStat = static_cast<Stat>(in.byte());
+        item.boostAmount = static_cast<int>(in.integer());
+        team.items.push_back(item);
+    }
+    return team;
+}
+
+// Encode one battle, length prefix included
+std::string encodeBattle(const BattleRecord& record) {
+    ByteWriter body;
+    uint32_t difficultyBits;
+    std::memcpy(&difficultyBits, &record.difficulty, sizeof(difficultyBits));
+    body.fixed(record.dataHash, 8);
+    body.fixed(record.seed, 8);
+    body.byte(static_cast<uint8_t>(record.environment));
+    body.fixed(difficultyBits, 4);
+    body.integer(record.turnLimit);
+    body.byte(record.playerWon ? 1 : 0);
+    body.integer(record.turns);
+    writeTeam(body, record.teams[0]);
+    writeTeam(body, record.teams[1]);
+    body.varint(record.decisions.size());
+    for (const BattleDecision& decision : record.decisions) {
+        writeDecision(body, decision);
+    }
+
+    ByteWriter framed;
+    framed.varint(body.bytes.size());
+    framed.bytes += body.bytes;
+    return framed.bytes;
+}
+
+// Decode one battle body
+bool decodeBattle(ByteReader& in, BattleRecord& record) {
+    record.dataHash = in.fixed(8);
+    record.seed = in.fixed(8);
+    record.environment = static_cast<BattleEnvironment>(in.byte());
+    uint32_t difficultyBits = static_cast<uint32_t>(in.fixed(4));
+    std::memcpy(&record.difficulty, &difficultyBits, sizeof(difficultyBits));
+    record.turnLimit = static_cast<int>(in.integer());
+    record.playerWon = in.byte() != 0;
+    record.turns = static_cast<int>(in.integer());
+    record.teams[0] = readTeam(in);
+    record.teams[1] = readTeam(in);
+    uint64_t decisionCount = in.varint();
+    record.decisions.clear();
+    for (uint64_t i = 0; i < decisionCount && in.good(); ++i) {
+        record.decisions.push_back(readDecision(in));
+    }
+    return in.good() && in.atEnd();
+}
+
+// Write the file header
+void writeHeader(std::ostream& file) {
+    ByteWriter header;
+    header.bytes.assign(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    header.fixed(REPLAY_VERSION, 4);
+    file.write(header.bytes.data(), static_cast<std::streamsize>(header.bytes.size()));
+}
+
+} // namespace
+
+BattleRecord makeBattleRecord(const Team& player, const Team& enemy, float difficulty,
+                              BattleEnvironment environment, uint64_t seed, int turnLimit) {
+    BattleRecord record;
+    record.dataHash = DataGeneration::active().hash();
+    record.seed = seed;
+    record.environment = environment;
+    record.difficulty = difficulty;
+    record.turnLimit = turnLimit;
+    record.teams[0] = recordTeam(player);
+    record.teams[1] = recordTeam(enemy);
+    return record;
+}
+
+bool replayBattle(const BattleRecord& record, std::ostream* output) {
+    if (record.dataHash != DataGeneration::active().hash()) {
+        throw std::runtime_error("Replay was recorded with different game data");
+    }
+    Team player = restoreTeam(record.teams[0]);
+    Team enemy = restoreTeam(record.teams[1]);
+
+    // One policy plays both sides' decisions back in their original order
+    ReplayPolicy policy(record.decisions);
+    Battle battle(player, enemy, record.difficulty, Environment(record.environment), policy, policy,
+                  record.seed, output);
+    battle.setTurnLimit(record.turnLimit);
+    return battle.start();
+}
 
 bool RecordLog::saveToFile(const std::string& filename) {
-    std::ofstream file(filename);
+    return stats.saveToFile(filename);
+}
+
+bool RecordLog::loadFromFile(const std::string& filename) {
+    return stats.loadFromFile(filename);
+}
+
+void RecordLog::displayStats() const {
+    stats.display(std::cout);
+}
+
+bool RecordLog::addBattle(const BattleRecord& record, const std::string& filename) {
+    battles.push_back(record);
+
+    std::ofstream file(filename, std::ios::binary | std::ios::app);
     if (!file.is_open()) {
         return false;
     }
-    file << wins << "\n" << losses << "\n" << totalDamageDealt << "\n"
-         << totalDamageTaken << "\n" << pokemonDefeated << "\n"
-         << pokemonLost << "\n" << itemsUsed << "\n"
-         << criticalHits << "\n" << statusEffectsCaused << "\n"
-         << totalExperienceGained << "\n" << evolutionsTriggered << "\n";
-    file.close();
-    return true;
+    if (file.tellp() == 0) {
+        writeHeader(file);
+    }
+    std::string bytes = encodeBattle(record);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
 }
 
-bool RecordLog::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
+bool RecordLog::saveBattles(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
     if (!file.is_open()) {
         return false;
     }
-    file >> wins >> losses >> totalDamageDealt >> totalDamageTaken
-         >> pokemonDefeated >> pokemonLost >> itemsUsed
-         >> criticalHits >> statusEffectsCaused >> totalExperienceGained
-         >> evolutionsTriggered;
-    file.close();
-    return true;
+    writeHeader(file);
+    for (const BattleRecord& record : battles) {
+        std::string bytes = encodeBattle(record);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    return static_cast<bool>(file);
 }
 
-void RecordLog::displayStats() const {
-    std::cout << "Wins: " << wins << "\nLosses: " << losses
-              << "\nTotal Damage Dealt: " << totalDamageDealt
-              << "\nTotal Damage Taken: " << totalDamageTaken
-              << "\nPokemon Defeated: " << pokemonDefeated
-              << "\nPokemon Lost: " << pokemonLost
-              << "\nItems Used: " << itemsUsed
-              << "\nCritical Hits: " << criticalHits
-              << "\nStatus Effects Caused: " << statusEffectsCaused
-              << "\nTotal Experience Gained: " << totalExperienceGained
-              << "\nEvolutions Triggered: " << evolutionsTriggered << std::endl;
+bool RecordLog::loadBattles(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ByteReader in(contents.data(), contents.size());
+    for (char expected : REPLAY_MAGIC) {
+        if (static_cast<char>(in.byte()) != expected) {
+            return false;
+        }
+    }
+    if (in.fixed(4) != REPLAY_VERSION) {
+        return false;
+    }
+
+    battles.clear();
+    while (!in.atEnd()) {
+        ByteReader body = in.slice(in.varint());
+        BattleRecord record;
+        if (!in.good() || !decodeBattle(body, record)) {
+            return false;
+        }
+        battles.push_back(record);
+    }
+    return true;
 }
\ No newline at end of file
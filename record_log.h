@@ -2,33 +2,114 @@
 #define RECORD_LOG_H
 
 #include <string>
+#include <vector>
+#include <array>
+#include <ostream>
+#include <cstdint>
+#include "team.h"
+#include "environment.h"
+#include "battle_policy.h"
+#include "battle_stats.h"
+
+/**
+ * @brief One team member as it was when a battle started
+ *
+ * Species and moves are stored by name so a record outlives the IDs of the
+ * process that wrote it.
+ */
+struct PokemonRecord {
+    std::string species;
+    int level = 1;
+    int experience = 0;
+    int experienceToNextLevel = 0;
+    int hp = 0;
+    int maxHp = 0;
+    int attack = 0;
+    int defense = 0;
+    int specialAttack = 0;
+    int specialDefense = 0;
+    int speed = 0;
+    StatusEffect status = StatusEffect::NONE;
+    std::array<int8_t, STAT_COUNT> statModifiers = {};
+    std::vector<std::string> moves;
+    std::vector<uint8_t> pp;
+};
+
+/**
+ * @brief One team as it was when a battle started
+ */
+struct TeamRecord {
+    std::vector<PokemonRecord> members;
+    std::vector<Item> items;            // One entry per inventory stack, in stack order
+    std::vector<int> itemCounts;        // Parallel to items: copies in each stack
+};
+
+/**
+ * @brief Everything needed to replay one battle exactly
+ *
+ * A battle is fully determined by the game data, the two teams, the seed of
+ * its dice and the decisions both sides made, so that is all a record keeps.
+ */
+struct BattleRecord {
+    uint64_t dataHash = 0;          // DataGeneration::hash() of the data the battle ran on
+    uint64_t seed = 0;
+    BattleEnvironment environment = BattleEnvironment::NORMAL;
+    float difficulty = 1.0f;
+    int turnLimit = 0;
+    bool playerWon = false;
+    int turns = 0;
+    TeamRecord teams[2];                    // Indexed by BattleSide
+    std::vector<BattleDecision> decisions;  // Both sides, in the order they were made
+};
+
+/**
+ * @brief Default replay file name
+ */
+constexpr const char* REPLAY_DEFAULT_FILE = "replays.bin";
+
+/**
+ * @brief Start a record of a battle about to be fought (fill in decisions and the outcome afterwards)
+ * @param player The player's team
+ * @param enemy The enemy team
+ * @param difficulty Difficulty multiplier
+ * @param environment Battle environment
+ * @param seed Seed of the battle
+ * @param turnLimit The battle's turn limit
+ * @return The record
+ */
+BattleRecord makeBattleRecord(const Team& player, const Team& enemy, float difficulty,
+                              BattleEnvironment environment, uint64_t seed, int turnLimit);
+
+/**
+ * @brief Fight a recorded battle again, decision by decision
+ * @param record The battle
+ * @param output Stream the battle text is rendered to (nullptr for none)
+ * @return True if the player won
+ * @throws std::runtime_error if the game data differs from the recorded one, a species or move is
+ *         unknown, or the battle runs past the recorded decisions
+ */
+bool replayBattle(const BattleRecord& record, std::ostream* output = nullptr);
 
 /**
  * @brief Class for tracking battle statistics
  */
 class RecordLog {
 public:
-    int wins = 0;
-    int losses = 0;
-    int totalDamageDealt = 0;
-    int totalDamageTaken = 0;
-    int pokemonDefeated = 0;
-    int pokemonLost = 0;
-    int itemsUsed = 0;
-    int criticalHits = 0;
-    int statusEffectsCaused = 0;
-    int totalExperienceGained = 0;
-    int evolutionsTriggered = 0;
+    // Totals of every battle counted so far
+    BattleStats stats;
+    
+    // Recorded battles, oldest first
+    std::vector<BattleRecord> battles;
     
     /**
-     * @brief Save record log to a file
+     * @brief Save record log to a file (versioned key=value lines)
      * @param filename The file to save to
      * @return True if successfully saved
      */
     bool saveToFile(const std::string& filename);
     
     /**
-     * @brief Load record log from a file
+     * @brief Load record log from a file (the older file of bare numbers is still read)
      * @param filename The file to load from
      * @return True if successfully loaded
      */
@@ -38,6 +119,28 @@ public:
      * @brief Display record statistics
      */
     void displayStats() const;
+    
+    /**
+     * @brief Keep a battle and append it to a replay file
+     * @param record The battle
+     * @param filename Replay file (created if missing)
+     * @return True if the battle was written to the file
+     */
+    bool addBattle(const BattleRecord& record, const std::string& filename);
+    
+    /**
+     * @brief Save every kept battle to a replay file, replacing it
+     * @param filename The file to save to
+     * @return True if successfully saved
+     */
+    bool saveBattles(const std::string& filename) const;
+    
+    /**
+     * @brief Load the battles of a replay file, replacing the kept ones
+     * @param filename The file to load from
+     * @return True if the file was read completely
+     */
+    bool loadBattles(const std::string& filename);
 };
 
 #endif // RECORD_LOG_H
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "rng.h"
+#include <random>
+
+// SplitMix64 step, used to expand seeds into full generator state
+static uint64_t splitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Constructor
+Rng::Rng(uint64_t seed) {
+    this->seed(seed);
+}
+
+// Create an independent stream derived from a master seed
+Rng Rng::forStream(uint64_t seed, uint64_t stream) {
+    // Mix the stream number through SplitMix64 so neighbouring streams are decorrelated
+    uint64_t mixer = stream;
+    return Rng(seed ^ splitMix64(mixer));
+}
+
+// Read one seed from the operating system
+uint64_t Rng::randomSeed() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+}
+
+// Reseed the generator
+void Rng::seed(uint64_t seed) {
+    uint64_t x = seed;
+    for (uint64_t& word : state) {
+        word = splitMix64(x);
+    }
+}
+
+// Draw a fresh generator from this one
+Rng Rng::split() {
+    return Rng((*this)());
+}
\ No newline at end of file
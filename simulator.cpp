@@ -0,0 +1,149 @@
+#include "simulator.h"
+#include "battle.h"
+#include "data_generation.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Running totals shared by all workers
+struct SimulationTotals {
+    long long battles = 0;
+    long long wins = 0;
+    double turnSum = 0.0;
+    double turnSquaredSum = 0.0;
+};
+
+// Fill in rates and confidence intervals from the totals
+SimulationResult summarize(const SimulationTotals& totals, double z) {
+    SimulationResult result;
+    result.battlesRun = static_cast<int>(totals.battles);
+    result.playerWins = static_cast<int>(totals.wins);
+    if (totals.battles == 0) {
+        return result;
+    }
+
+    double n = static_cast<double>(totals.battles);
+    double p = totals.wins / n;
+    result.winRate = p;
+
+    // Wilson score interval stays inside [0, 1] even for lopsided matchups
+    double z2 = z * z;
+    double center = (p + z2 / (2.0 * n)) / (1.0 + z2 / n);
+    double margin = z * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / (1.0 + z2 / n);
+    result.winRateLow = std::max(0.0, center - margin);
+    result.winRateHigh = std::min(1.0, center + margin);
+
+    result.meanTurns = totals.turnSum / n;
+    double variance = n > 1.0 ? (totals.turnSquaredSum - n * result.meanTurns * result.meanTurns) / (n - 1.0) : 0.0;
+    double turnMargin = z * std::sqrt(std::max(0.0, variance) / n);
+    result.meanTurnsLow = result.meanTurns - turnMargin;
+    result.meanTurnsHigh = result.meanTurns + turnMargin;
+
+    return result;
+}
+
+// Default policy for both sides
+std::unique_ptr<DecisionPolicy> makeRandomPolicy(uint64_t seed) {
+    return std::unique_ptr<DecisionPolicy>(new RandomMovePolicy(seed));
+}
+
+} // namespace
+
+// Constructor
+MatchupSimulator::MatchupSimulator(const Team& player, const Team& enemy, const Environment& env)
+    : playerTeam(player), enemyTeam(enemy), environment(env),
+      playerPolicyFactory(makeRandomPolicy), enemyPolicyFactory(makeRandomPolicy) {
+}
+
+// Set the policies used by each side
+void MatchupSimulator::setPolicies(PolicyFactory player, PolicyFactory enemy) {
+    playerPolicyFactory = player;
+    enemyPolicyFactory = enemy;
+}
+
+// Run the simulation
+SimulationResult MatchupSimulator::run(const SimulationConfig& config) const {
+    int threadCount = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, threadCount);
+    int batchSize = std::max(1, config.batchSize);
+
+    std::atomic<int> nextBattle(0);
+    std::atomic<bool> stop(false);
+    std::mutex totalsMutex;
+    SimulationTotals totals;
+    bool stoppedEarly = false;
+    StatShards shards(static_cast<size_t>(threadCount));
+
+    auto worker = [&](int workerIndex) {
+        StatsEventSink statsSink(shards.shard(static_cast<size_t>(workerIndex)));
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            int first = nextBattle.fetch_add(batchSize, std::memory_order_relaxed);
+            if (first >= config.battles) {
+                break;
+            }
+            int last = std::min(config.battles, first + batchSize);
+
+            SimulationTotals local;
+            for (int i = first; i < last; i++) {
+                // Each battle runs on one data generation, even if the files are reloaded meanwhile
+                GenerationPin pin;
+                
+                // The battle's seed and policies depend only on its index, not on the worker running it
+                Rng battleRng = Rng::forStream(config.seed, static_cast<uint64_t>(i));
+                std::unique_ptr<DecisionPolicy> playerPolicy = playerPolicyFactory(battleRng());
+                std::unique_ptr<DecisionPolicy> enemyPolicy = enemyPolicyFactory(battleRng());
+                Team player = playerTeam;
+                Team enemy = enemyTeam;
+                Battle battle(player, enemy, config.difficulty, environment,
+                              *playerPolicy, *enemyPolicy, battleRng());
+                if (config.collectStats) {
+                    battle.addEventSink(statsSink);
+                }
+
+                bool won = battle.start();
+                double turns = battle.getTurnCount();
+                local.battles++;
+                local.wins += won ? 1 : 0;
+                local.turnSum += turns;
+                local.turnSquaredSum += turns * turns;
+            }
+
+            std::lock_guard<std::mutex> lock(totalsMutex);
+            totals.battles += local.battles;
+            totals.wins += local.wins;
+            totals.turnSum += local.turnSum;
+            totals.turnSquaredSum += local.turnSquaredSum;
+
+            // Early stopping once the win rate is known precisely enough
+            if (config.targetHalfWidth > 0.0 && totals.battles >= config.minBattles) {
+                SimulationResult current = summarize(totals, config.confidenceZ);
+                if ((current.winRateHigh - current.winRateLow) / 2.0 <= config.targetHalfWidth) {
+                    stoppedEarly = true;
+                    stop.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    SimulationResult result = summarize(totals, config.confidenceZ);
+    result.stoppedEarly = stoppedEarly;
+    if (config.collectStats) {
+        result.stats = shards.merged();
+    }
+    return result;
+}
\ No newline at end of file
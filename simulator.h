@@ -0,0 +1,87 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <functional>
+#include <memory>
+#include "team.h"
+#include "environment.h"
+#include "battle_policy.h"
+#include "battle_stats.h"
+
+/**
+ * @brief Settings for a batch of simulated battles
+ */
+struct SimulationConfig {
+    int battles = 10000;            // Maximum number of battles to run
+    int threads = 0;                // Worker threads (0 = one per hardware thread)
+    uint64_t seed = 0;              // Master seed; each battle derives its own stream from it and its index
+    float difficulty = 1.0f;        // Difficulty multiplier passed to every battle
+    int batchSize = 256;            // Battles a worker claims at a time
+    double confidenceZ = 1.96;      // z-score of the confidence intervals (1.96 = 95%)
+    double targetHalfWidth = 0.0;   // Stop early once the win rate interval is this tight (0 = never)
+    int minBattles = 1000;          // Battles to run before early stopping is considered
+    bool collectStats = true;       // Count damage, faints, items and histograms into the result
+};
+
+/**
+ * @brief Aggregated results of a batch of simulated battles
+ */
+struct SimulationResult {
+    int battlesRun = 0;
+    int playerWins = 0;
+    double winRate = 0.0;
+    double winRateLow = 0.0;        // Wilson score interval
+    double winRateHigh = 0.0;
+    double meanTurns = 0.0;
+    double meanTurnsLow = 0.0;      // Normal approximation interval
+    double meanTurnsHigh = 0.0;
+    bool stoppedEarly = false;
+    BattleStats stats;              // Merged from every worker (empty unless collectStats is set)
+};
+
+/**
+ * @brief Creates a fresh decision policy for one battle
+ */
+using PolicyFactory = std::function<std::unique_ptr<DecisionPolicy>(uint64_t seed)>;
+
+/**
+ * @brief Runs many independent headless battles between two teams on a thread pool
+ *
+ * Battle i is seeded, and gets fresh policies, from a stream derived from the
+ * master seed and i, so the results don't depend on the thread count, the
+ * batch size or which worker ran which battle. Early stopping is the
+ * exception: where a run stops depends on the order batches finish in.
+ */
+class MatchupSimulator {
+public:
+    /**
+     * @brief Constructor for MatchupSimulator
+     * @param player The player's team definition (copied for every battle)
+     * @param enemy The enemy team definition (copied for every battle)
+     * @param env Battle environment
+     */
+    MatchupSimulator(const Team& player, const Team& enemy, const Environment& env);
+
+    /**
+     * @brief Set the policies used by each side (both default to random moves)
+     * @param player Factory for the player's policy
+     * @param enemy Factory for the enemy's policy
+     */
+    void setPolicies(PolicyFactory player, PolicyFactory enemy);
+
+    /**
+     * @brief Run the simulation
+     * @param config Simulation settings
+     * @return Aggregated results
+     */
+    SimulationResult run(const SimulationConfig& config) const;
+
+private:
+    Team playerTeam;
+    Team enemyTeam;
+    Environment environment;
+    PolicyFactory playerPolicyFactory;
+    PolicyFactory enemyPolicyFactory;
+};
+
+#endif // SIMULATOR_H
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "species.h"
+#include "data_generation.h"
+#include <stdexcept>
+
+// Get the registry of the calling thread's data generation
+SpeciesRegistry& SpeciesRegistry::instance() {
+    return DataGeneration::active().species;
+}
+
+// Copy a registry, keeping every ID
+SpeciesRegistry::SpeciesRegistry(const SpeciesRegistry& other) {
+    std::lock_guard<std::mutex> lock(other.mutex);
+    species = other.species;
+    byName = other.byName;
+}
+
+// Register a species, or find it if it is already known
+SpeciesId SpeciesRegistry::add(const Species& entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byName.find(entry.name);
+    if (it != byName.end()) {
+        return it->second;
+    }
+    if (sealed) {
+        throw std::runtime_error("Cannot register the species " + entry.name + ": its data generation is published");
+    }
+    if (species.size() >= INVALID_SPECIES_ID) {
+        return INVALID_SPECIES_ID;
+    }
+    
+    SpeciesId id = static_cast<SpeciesId>(species.size());
+    species.push_back(entry);
+    species.back().defensiveProfile = &getDefensiveProfile(entry.primaryType, entry.secondaryType);
+    byName.emplace(entry.name, id);
+    return id;
+}
+
+// Register a species, overwriting a known species' data
+SpeciesId SpeciesRegistry::set(const Species& entry) {
+    SpeciesId id = add(entry);
+    if (id != INVALID_SPECIES_ID) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (sealed) {
+            throw std::runtime_error("Cannot change the species " + entry.name + ": its data generation is published");
+        }
+        species[id] = entry;
+        species[id].defensiveProfile = &getDefensiveProfile(entry.primaryType, entry.secondaryType);
+    }
+    return id;
+}
+
+// Link a species to the species it evolves into
+void SpeciesRegistry::setEvolution(SpeciesId id, SpeciesId target, int level) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (sealed) {
+        throw std::runtime_error("Cannot change an evolution: the data generation is published");
+    }
+    if (id >= species.size() || (target != INVALID_SPECIES_ID && target >= species.size())) {
+        return;
+    }
+    species[id].evolution = target;
+    species[id].evolutionLevel = level;
+}
+
+// Refuse every later change
+void SpeciesRegistry::seal() {
+    std::lock_guard<std::mutex> lock(mutex);
+    sealed = true;
+}
+
+// Look up a species by name
+SpeciesId SpeciesRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byName.find(name);
+    return it != byName.end() ? it->second : INVALID_SPECIES_ID;
+}
+
+// Get the number of registered species
+size_t SpeciesRegistry::size() const {
+    return species.size();
+}
\ No newline at end of file
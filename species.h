@@ -0,0 +1,125 @@
+#ifndef SPECIES_H
+#define SPECIES_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include "types.h"
+
+/**
+ * @brief Compact handle of a species in the species registry
+ */
+using SpeciesId = uint16_t;
+
+constexpr SpeciesId INVALID_SPECIES_ID = 0xFFFF;
+
+/**
+ * @brief Immutable data shared by every Pokemon of one species
+ */
+struct Species {
+    std::string name;
+    int baseHp = 0;
+    int baseAttack = 0;
+    int baseDefense = 0;
+    int baseSpecialAttack = 0;
+    int baseSpecialDefense = 0;
+    int baseSpeed = 0;
+    PokemonType primaryType = PokemonType::NORMAL;
+    PokemonType secondaryType = PokemonType::NONE;
+    const DefensiveProfile* defensiveProfile = nullptr;    // Filled in on registration
+    SpeciesId evolution = INVALID_SPECIES_ID;              // Species it evolves into, if any
+    int evolutionLevel = 0;
+
+    /**
+     * @brief Check if the species evolves
+     * @return True if it has an evolution
+     */
+    bool canEvolve() const { return evolution != INVALID_SPECIES_ID; }
+};
+
+/**
+ * @brief Table of every known species, interned by name (flyweight)
+ *
+ * Pokemon only hold a SpeciesId, so names, types and evolution data are
+ * never copied with a team. Each DataGeneration owns one registry; species
+ * are registered while a generation is loaded, and publishing it seals the
+ * registry against further changes. IDs carry over from one generation to
+ * the next.
+ */
+class SpeciesRegistry {
+public:
+    SpeciesRegistry() = default;
+    
+    /**
+     * @brief Copy a registry, keeping every ID (used to start the next data generation)
+     * @param other The registry to copy
+     */
+    SpeciesRegistry(const SpeciesRegistry& other);
+    SpeciesRegistry& operator=(const SpeciesRegistry&) = delete;
+    
+    /**
+     * @brief Get the registry of the calling thread's data generation
+     * @return The registry
+     */
+    static SpeciesRegistry& instance();
+
+    /**
+     * @brief Register a species, or find it if a species with the same name exists
+     * @param species The species to register
+     * @return The species' ID
+     * @throws std::runtime_error if the species is new and the registry is sealed
+     */
+    SpeciesId add(const Species& species);
+
+    /**
+     * @brief Register a species, overwriting the data of a species with the same name
+     * @param species The species to register
+     * @return The species' ID (unchanged for a known name)
+     * @throws std::runtime_error if the registry is sealed
+     */
+    SpeciesId set(const Species& species);
+
+    /**
+     * @brief Link a species to the species it evolves into
+     * @param id The species that evolves
+     * @param target The species it evolves into
+     * @param level Level at which it evolves
+     * @throws std::runtime_error if the registry is sealed
+     */
+    void setEvolution(SpeciesId id, SpeciesId target, int level);
+
+    /**
+     * @brief Refuse every later change (called when the registry's data generation is published)
+     */
+    void seal();
+
+    /**
+     * @brief Look up a species by name
+     * @param name The species' name
+     * @return The species' ID, or INVALID_SPECIES_ID if it isn't registered
+     */
+    SpeciesId find(const std::string& name) const;
+
+    /**
+     * @brief Get a registered species
+     * @param id The species' ID (must be valid)
+     * @return The species
+     */
+    const Species& get(SpeciesId id) const { return species[id]; }
+
+    /**
+     * @brief Get the number of registered species
+     * @return Species count
+     */
+    size_t size() const;
+
+private:
+    std::vector<Species> species;
+    std::unordered_map<std::string, SpeciesId> byName;
+    bool sealed = false;        // Set once the generation is published; copies start unsealed
+    mutable std::mutex mutex;   // Guards registration only
+};
+
+#endif // SPECIES_H
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "stats.h"
+#include <unordered_map>
+
+// Stat to string mapping
+std::string statToString(Stat stat) {
+    static const std::unordered_map<Stat, std::string> statMap = {
+        {Stat::ATTACK, "Attack"},
+        {Stat::DEFENSE, "Defense"},
+        {Stat::SPECIAL_ATTACK, "Special Attack"},
+        {Stat::SPECIAL_DEFENSE, "Special Defense"},
+        {Stat::SPEED, "Speed"},
+        {Stat::ACCURACY, "Accuracy"},
+        {Stat::EVASION, "Evasion"},
+        {Stat::NONE, "None"}
+    };
+    
+    return statMap.at(stat);
+}
+
+// String to stat mapping (names as used in the data files)
+Stat stringToStat(const std::string& statStr) {
+    static const std::unordered_map<std::string, Stat> stringMap = {
+        {"attack", Stat::ATTACK},
+        {"defense", Stat::DEFENSE},
+        {"specialAttack", Stat::SPECIAL_ATTACK},
+        {"specialDefense", Stat::SPECIAL_DEFENSE},
+        {"speed", Stat::SPEED},
+        {"accuracy", Stat::ACCURACY},
+        {"evasion", Stat::EVASION}
+    };
+    
+    auto it = stringMap.find(statStr);
+    return (it != stringMap.end()) ? it->second : Stat::NONE;
+}
\ No newline at end of file
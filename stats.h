@@ -0,0 +1,96 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <string>
+
+/**
+ * @brief Enum representing the stats that can be raised or lowered in battle
+ */
+enum class Stat {
+    ATTACK,
+    DEFENSE,
+    SPECIAL_ATTACK,
+    SPECIAL_DEFENSE,
+    SPEED,
+    ACCURACY,
+    EVASION,
+    NONE
+};
+
+/**
+ * @brief Number of modifiable stats (excluding NONE)
+ */
+constexpr int STAT_COUNT = static_cast<int>(Stat::NONE);
+
+/**
+ * @brief Lowest and highest stat stage
+ */
+constexpr int MIN_STAT_STAGE = -6;
+constexpr int MAX_STAT_STAGE = 6;
+constexpr int STAT_STAGE_COUNT = MAX_STAT_STAGE - MIN_STAT_STAGE + 1;
+
+/**
+ * @brief Stage multiplier tables indexed by stage - MIN_STAT_STAGE
+ */
+struct StatStageTable {
+    float multipliers[STAT_STAGE_COUNT];
+};
+
+/**
+ * @brief Builds a stage multiplier table
+ * @param base 2 for battle stats ((2+n)/2), 3 for accuracy and evasion ((3+n)/3)
+ * @return Multipliers for stages -6..+6
+ */
+constexpr StatStageTable makeStatStageTable(float base) {
+    StatStageTable table{};
+    for (int stage = MIN_STAT_STAGE; stage <= MAX_STAT_STAGE; ++stage) {
+        table.multipliers[stage - MIN_STAT_STAGE] = (stage >= 0) ? (base + stage) / base : base / (base - stage);
+    }
+    return table;
+}
+
+inline constexpr StatStageTable STAT_STAGE_MULTIPLIERS = makeStatStageTable(2.0f);
+inline constexpr StatStageTable ACCURACY_STAGE_MULTIPLIERS = makeStatStageTable(3.0f);
+
+/**
+ * @brief Clamps a stage to the valid range
+ * @param stage The stage to clamp
+ * @return Stage between -6 and +6
+ */
+constexpr int clampStatStage(int stage) {
+    return stage < MIN_STAT_STAGE ? MIN_STAT_STAGE : (stage > MAX_STAT_STAGE ? MAX_STAT_STAGE : stage);
+}
+
+/**
+ * @brief Gets the multiplier for an attack/defense/speed stage
+ * @param stage The stat stage (clamped to -6..+6)
+ * @return Stat multiplier
+ */
+constexpr float getStatStageMultiplier(int stage) {
+    return STAT_STAGE_MULTIPLIERS.multipliers[clampStatStage(stage) - MIN_STAT_STAGE];
+}
+
+/**
+ * @brief Gets the multiplier for a combined accuracy - evasion stage
+ * @param stage The accuracy stage minus the evasion stage (clamped to -6..+6)
+ * @return Accuracy multiplier
+ */
+constexpr float getAccuracyStageMultiplier(int stage) {
+    return ACCURACY_STAGE_MULTIPLIERS.multipliers[clampStatStage(stage) - MIN_STAT_STAGE];
+}
+
+/**
+ * @brief Converts Stat enum to a display string
+ * @param stat The Stat to convert
+ * @return Human readable name of the stat
+ */
+std::string statToString(Stat stat);
+
+/**
+ * @brief Converts a data file stat name (e.g. "specialAttack") to a Stat
+ * @param statStr The string to convert
+ * @return Stat corresponding to the string, or NONE if unknown
+ */
+Stat stringToStat(const std::string& statStr);
+
+#endif // STATS_H
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include "status.h"
-#include <random>
 #include <unordered_map>
 #include <sstream>
 
@@ -18,6 +17,22 @@ std::string statusToString(StatusEffect status) {
     return statusMap.at(status);
 }
 
+// Convert a status effect name from the data files to a status
+StatusEffect stringToStatus(const std::string& statusStr) {
+    static const std::unordered_map<std::string, StatusEffect> stringMap = {
+        {"None", StatusEffect::NONE},
+        {"Poison", StatusEffect::POISON},
+        {"Paralysis", StatusEffect::PARALYSIS},
+        {"Burn", StatusEffect::BURN},
+        {"Sleep", StatusEffect::SLEEP},
+        {"Freeze", StatusEffect::FROZEN},
+        {"Confusion", StatusEffect::CONFUSION}
+    };
+    
+    auto it = stringMap.find(statusStr);
+    return (it != stringMap.end()) ? it->second : StatusEffect::NONE;
+}
+
 // Get ANSI color codes for console output based on status
 std::string getStatusColor(StatusEffect status) {
     static const std::unordered_map<StatusEffect, std::string> colorMap = {
@@ -35,10 +50,8 @@ std::string getStatusColor(StatusEffect status) {
 }
 
 // Apply status effects
-std::string applyStatusEffect(StatusEffect status, bool& canMove, int& currentHp, int maxHp) {
+std::string applyStatusEffect(StatusEffect status, bool& canMove, int& currentHp, int maxHp, Rng& rng) {
     std::stringstream result;
-    std::random_device rd;
-    std::mt19937 gen(rd());
     
     // Default to being able to move
     canMove = true;
@@ -56,8 +69,7 @@ std::string applyStatusEffect(StatusEffect status, bool& canMove, int& currentHp
         case StatusEffect::PARALYSIS:
             // 25% chance of not being able to move
             {
-                std::uniform_int_distribution<> dis(1, 100);
-                if (dis(gen) <= 25) {
+                if (rng.rollPercent(25)) {
                     canMove = false;
                     result << "It's fully paralyzed!";
                 }
@@ -88,8 +100,7 @@ std::string applyStatusEffect(StatusEffect status, bool& canMove, int& currentHp
         case StatusEffect::CONFUSION:
             // 33% chance of hitting itself
             {
-                std::uniform_int_distribution<> dis(1, 100);
-                if (dis(gen) <= 33) {
+                if (rng.rollPercent(33)) {
                     canMove = false;
                     int damage = maxHp / 8;
                     currentHp -= damage;
@@ -109,32 +120,20 @@ std::string applyStatusEffect(StatusEffect status, bool& canMove, int& currentHp
 }
 
 // Check for status recovery
-bool checkStatusRecovery(StatusEffect status) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    
+bool checkStatusRecovery(StatusEffect status, Rng& rng) {
     // Different recovery rates for different statuses
     switch (status) {
         case StatusEffect::SLEEP:
             // 33% chance to wake up each turn
-            {
-                std::uniform_int_distribution<> dis(1, 100);
-                return dis(gen) <= 33;
-            }
+            return rng.rollPercent(33);
             
         case StatusEffect::FROZEN:
             // 20% chance to thaw each turn
-            {
-                std::uniform_int_distribution<> dis(1, 100);
-                return dis(gen) <= 20;
-            }
+            return rng.rollPercent(20);
             
         case StatusEffect::CONFUSION:
             // 25% chance to snap out of confusion each turn
-            {
-                std::uniform_int_distribution<> dis(1, 100);
-                return dis(gen) <= 25;
-            }
+            return rng.rollPercent(25);
             
         default:
             // Other status effects don't auto-recover
@@ -2,6 +2,7 @@
 #define STATUS_H
 
 #include <string>
+#include "rng.h"
 
 /**
  * @brief Enum representing different status effects
@@ -23,6 +24,13 @@ enum class StatusEffect {
  */
 std::string statusToString(StatusEffect status);
 
+/**
+ * @brief Converts a status effect name from the data files to an enum value
+ * @param statusStr The status name (e.g. "Burn", "Freeze")
+ * @return The status effect (NONE if not recognised)
+ */
+StatusEffect stringToStatus(const std::string& statusStr);
+
 /**
  * @brief Gets a color code for console output based on status effect
  * @param status The status effect
@@ -36,15 +44,17 @@ std::string getStatusColor(StatusEffect status);
  * @param canMove Reference to a boolean that determines if Pokemon can move
  * @param currentHp Reference to the Pokemon's current HP
  * @param maxHp The Pokemon's max HP (for percentage calculations)
+ * @param rng The battle's random number generator
  * @return String describing what happened due to status
  */
-std::string applyStatusEffect(StatusEffect status, bool& canMove, int& currentHp, int maxHp);
+std::string applyStatusEffect(StatusEffect status, bool& canMove, int& currentHp, int maxHp, Rng& rng);
 
 /**
  * @brief Calculates chance of status recovery
  * @param status The status effect to check
+ * @param rng The battle's random number generator
  * @return True if the Pokemon recovers from status
  */
-bool checkStatusRecovery(StatusEffect status);
+bool checkStatusRecovery(StatusEffect status, Rng& rng);
 
 #endif // STATUS_H
\ No newline at end of file
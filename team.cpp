@@ -1,48 +1,71 @@
 #include "team.h"
 #include <algorithm>
-#include <stdexcept>
 
 // Default constructor
-Team::Team() {}
+Team::Team() : aliveMask(0) {}
 
 // Add a Pokemon to the team
 bool Team::addPokemon(const Pokemon& pokemon) {
     if (members.size() < 6) {  // Pokemon teams can have up to 6 members
         members.push_back(pokemon);
+        updateAlive(static_cast<int>(members.size()) - 1);
         return true;
     }
     return false;
 }
 
+// Replace a member
+void Team::setMember(int index, const Pokemon& pokemon) {
+    members[index] = pokemon;
+    updateAlive(index);
+}
+
+// Swap two members' places in the line-up
+void Team::swapMembers(int first, int second) {
+    std::swap(members[first], members[second]);
+    updateAlive(first);
+    updateAlive(second);
+}
+
+// Remove every member
+void Team::clearMembers() {
+    members.clear();
+    aliveMask = 0;
+}
+
 // Add an item to the team inventory
-void Team::addItem(const Item& item) {
-    items.push_back(item);
+bool Team::addItem(const Item& item, int amount) {
+    return items.add(itemRegistry().add(item), amount);
 }
 
-// Check if the team is defeated
-bool Team::isDefeated() const {
-    return std::all_of(members.begin(), members.end(), [](const Pokemon& p) { 
-        return p.isDefeated(); 
-    });
+// Set a member's HP and track whether it can still battle
+void Team::setHp(int index, int hp) {
+    members[index].hp = std::max(0, hp);
+    updateAlive(index);
+}
+
+// Recompute which members can still battle
+void Team::refreshAlive() {
+    aliveMask = 0;
+    for (int i = 0; i < static_cast<int>(members.size()); i++) {
+        updateAlive(i);
+    }
+}
+
+// Update one member's bit of the alive mask
+void Team::updateAlive(int index) {
+    uint8_t bit = static_cast<uint8_t>(1u << index);
+    aliveMask = static_cast<uint8_t>(members[index].isDefeated() ? aliveMask & ~bit : aliveMask | bit);
 }
 
 // Reset the team (heal all Pokemon)
 void Team::resetTeam() {
     for (auto& pokemon : members) {
         pokemon.resetHp();
+        pokemon.restorePp();
         pokemon.status = StatusEffect::NONE;
     }
-}
-
-// Get the first non-defeated Pokemon
-Pokemon& Team::getFirstAlivePokemon() {
-    for (auto& pokemon : members) {
-        if (!pokemon.isDefeated()) {
-            return pokemon;
-        }
-    }
-    // This should never happen if we check for team defeat properly
-    throw std::runtime_error("No alive Pokemon found!");
+    refreshAlive();
 }
 
 // Use an item from inventory on a Pokemon
@@ -57,10 +80,11 @@ std::string Team::useItem(int itemIndex, int pokemonIndex) {
     }
     
     // Use the item on the Pokemon
-    std::string result = members[pokemonIndex].useItem(items[itemIndex]);
+    std::string result = members[pokemonIndex].useItem(items.getItem(itemIndex));
+    updateAlive(pokemonIndex);
     
-    // Remove the item from inventory
-    items.erase(items.begin() + itemIndex);
+    // Take it out of its stack
+    items.takeOne(itemIndex);
     
     return result;
 }
\ No newline at end of file
@@ -3,11 +3,21 @@
 
 #include <vector>
 #include <string>
+#include <optional>
+#include <cstdint>
 #include "pokemon.h"
 #include "item.h"
+#include "inventory.h"
+#include "metrics.h"
 
 /**
  * @brief Class representing a team of Pokemon
+ *
+ * The team keeps a bitmask of the members that can still battle, so defeat
+ * checks and first-alive lookups are single bit operations. Members are only
+ * changed through the team: HP through setHp and useItem, the line-up through
+ * addPokemon, setMember, swapMembers and clearMembers, so the mask is always
+ * current. Items are kept as counted stacks (see Inventory).
  */
 class Team {
 public:
@@ -16,8 +26,33 @@ public:
      */
     Team();
     
-    std::vector<Pokemon> members;
-    std::vector<Item> items;
+    Inventory items;
+    
+    /**
+     * @brief Get the number of members
+     * @return Member count (at most 6)
+     */
+    int size() const { return static_cast<int>(members.size()); }
+    
+    /**
+     * @brief Get every member, in line-up order
+     * @return The members
+     */
+    const std::vector<Pokemon>& getMembers() const { return members; }
+    
+    /**
+     * @brief Get a member
+     * @param index The member's index (must be valid)
+     * @return The member
+     */
+    const Pokemon& getMember(int index) const { return members[index]; }
+    
+    /**
+     * @brief Get a member to change anything but its HP (status, PP, experience); HP goes through setHp
+     * @param index The member's index (must be valid)
+     * @return The member
+     */
+    Pokemon& getMember(int index) { return members[index]; }
     
     /**
      * @brief Add a Pokemon to the team
@@ -27,10 +62,32 @@ public:
     bool addPokemon(const Pokemon& pokemon);
     
     /**
-     * @brief Add an item to the team inventory
+     * @brief Replace a member
+     * @param index The member's index (must be valid)
+     * @param pokemon The Pokemon that takes its place
+     */
+    void setMember(int index, const Pokemon& pokemon);
+    
+    /**
+     * @brief Swap two members' places in the line-up
+     * @param first One member's index
+     * @param second The other member's index
+     */
+    void swapMembers(int first, int second);
+    
+    /**
+     * @brief Remove every member (the items stay)
+     */
+    void clearMembers();
+    
+    /**
+     * @brief Add an item to the team inventory, stacking it with identical items
      * @param item The item to add
+     * @param amount Number of copies to add
+     * @return True if the item was added (false if the inventory is full)
+     * @throws std::runtime_error if the item is new and the thread's data generation is published
      */
-    void addItem(const Item& item);
+    bool addItem(const Item& item, int amount = 1);
     
     /**
      * @brief Check if the team is defeated
@@ -39,24 +96,71 @@ public:
     bool isDefeated() const;
     
     /**
-     * @brief Reset the team (heal all Pokemon)
+     * @brief Get the index of the first non-defeated Pokemon
+     * @return The index, or no value if all Pokemon are defeated
      */
-    void resetTeam();
+    std::optional<int> getFirstAliveIndex() const;
+    
+    /**
+     * @brief Get the members that can still battle
+     * @return Bit i is set if member i has HP left
+     */
+    uint8_t getAliveMask() const { return aliveMask; }
     
     /**
-     * @brief Get the first non-defeated Pokemon
-     * @return Reference to the first available Pokemon
-     * @throws std::runtime_error if no Pokemon are available
+     * @brief Set a member's HP (clamped at 0) and track whether it can still battle
+     * @param index The member's index
+     * @param hp The new HP
      */
-    Pokemon& getFirstAlivePokemon();
+    void setHp(int index, int hp);
+    
+    /**
+     * @brief Reset the team (heal all Pokemon)
+     */
+    void resetTeam();
     
     /**
-     * @brief Use an item from inventory on a Pokemon
-     * @param itemIndex The index of the item to use
+     * @brief Use one item of an inventory stack on a Pokemon
+     * @param itemIndex The index of the stack to use (a stack that runs out is replaced by the last one)
      * @param pokemonIndex The index of the Pokemon to use the item on
      * @return String describing the effect
      */
     std::string useItem(int itemIndex, int pokemonIndex);
+    
+private:
+    std::vector<Pokemon> members;
+    uint8_t aliveMask;      // Bit i: members[i] can still battle (teams have at most 6 members)
+    
+    /**
+     * @brief Recompute which members can still battle
+     */
+    void refreshAlive();
+    
+    /**
+     * @brief Update one member's bit of the alive mask
+     * @param index The member's index
+     */
+    void updateAlive(int index);
 };
 
+inline bool Team::isDefeated() const {
+    return aliveMask == 0;
+}
+
+inline std::optional<int> Team::getFirstAliveIndex() const {
+    Metrics::count(Metric::FIRST_ALIVE);
+    if (aliveMask == 0) {
+        return std::nullopt;
+    }
+#if defined(__GNUC__)
+    return __builtin_ctz(aliveMask);
+#else
+    int index = 0;
+    while (!(aliveMask & (1u << index))) {
+        index++;
+    }
+    return index;
+#endif
+}
+
 #endif // TEAM_H
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "transposition_table.h"
+#include <cstring>
+
+namespace {
+
+// Packed layout: value bits 0-31, best action + 1 bits 32-39, depth bits 40-47, bound bits 48-49, generation bits 56-63
+uint64_t pack(const TableEntry& entry, uint8_t generation) {
+    uint32_t valueBits;
+    std::memcpy(&valueBits, &entry.value, sizeof(valueBits));
+    uint64_t action = static_cast<uint8_t>(entry.bestAction + 1);
+    uint64_t depth = static_cast<uint8_t>(entry.depth < 0 ? 0 : (entry.depth > 255 ? 255 : entry.depth));
+    return valueBits | (action << 32) | (depth << 40) |
+           (static_cast<uint64_t>(entry.bound) << 48) | (static_cast<uint64_t>(generation) << 56);
+}
+
+TableEntry unpack(uint64_t data) {
+    TableEntry entry;
+    uint32_t valueBits = static_cast<uint32_t>(data);
+    std::memcpy(&entry.value, &valueBits, sizeof(valueBits));
+    entry.bestAction = static_cast<int>((data >> 32) & 0xFF) - 1;
+    entry.depth = static_cast<int>((data >> 40) & 0xFF);
+    entry.bound = static_cast<BoundType>((data >> 48) & 0x3);
+    return entry;
+}
+
+uint8_t generationOf(uint64_t data) {
+    return static_cast<uint8_t>(data >> 56);
+}
+
+} // namespace
+
+// Constructor
+TranspositionTable::TranspositionTable(size_t entries) : generation(0), probes(0), hits(0) {
+    size_t size = 1;
+    while (size * 2 <= entries) {
+        size *= 2;
+    }
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+    clear();
+}
+
+// Look up a position
+bool TranspositionTable::probe(uint64_t key, TableEntry& entry) const {
+    probes.fetch_add(1, std::memory_order_relaxed);
+    const Slot& slot = slots[key & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key || data == 0) {
+        return false;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    entry = unpack(data);
+    return true;
+}
+
+// Store a search result
+void TranspositionTable::store(uint64_t key, const TableEntry& entry) {
+    Slot& slot = slots[key & mask];
+    uint8_t current = generation.load(std::memory_order_relaxed);
+    uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    uint64_t oldCheck = slot.check.load(std::memory_order_relaxed);
+
+    // Keep a deeper result for another position of the current search
+    bool samePosition = (oldCheck ^ oldData) == key;
+    if (!samePosition && oldData != 0 && generationOf(oldData) == current &&
+        unpack(oldData).depth > entry.depth) {
+        return;
+    }
+
+    uint64_t data = pack(entry, current);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+// Start a new search
+void TranspositionTable::newSearch() {
+    generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Empty the table and reset the statistics
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; ++i) {
+        slots[i].check.store(0, std::memory_order_relaxed);
+        slots[i].data.store(0, std::memory_order_relaxed);
+    }
+    probes.store(0, std::memory_order_relaxed);
+    hits.store(0, std::memory_order_relaxed);
+}
+
+// Get the number of slots
+size_t TranspositionTable::size() const {
+    return mask + 1;
+}
+
+// Get the fraction of probes that found their position
+double TranspositionTable::hitRate() const {
+    uint64_t probeCount = probes.load(std::memory_order_relaxed);
+    return probeCount > 0 ? static_cast<double>(hits.load(std::memory_order_relaxed)) / probeCount : 0.0;
+}
+
+// Get the number of lookups
+uint64_t TranspositionTable::getProbes() const {
+    return probes.load(std::memory_order_relaxed);
+}
+
+// Get the number of successful lookups
+uint64_t TranspositionTable::getHits() const {
+    return hits.load(std::memory_order_relaxed);
+}
\ No newline at end of file
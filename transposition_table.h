@@ -0,0 +1,108 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief How a stored value relates to the true value of a position
+ */
+enum class BoundType : uint8_t {
+    EXACT,
+    LOWER,      // The search failed high; the true value is at least this
+    UPPER       // The search failed low; the true value is at most this
+};
+
+/**
+ * @brief A search result for one position
+ */
+struct TableEntry {
+    float value = 0.0f;
+    int bestAction = -1;        // -1 if no best action is known
+    int depth = 0;
+    BoundType bound = BoundType::EXACT;
+};
+
+/**
+ * @brief Fixed-size, lock-free transposition table keyed by Zobrist hashes
+ *
+ * Each slot holds two atomic words, the packed entry and key ^ entry. A
+ * reader only accepts a slot whose words XOR back to its key, so an entry torn
+ * by two threads writing at once is just a miss. Any number of search threads
+ * can share one table.
+ */
+class TranspositionTable {
+public:
+    static constexpr size_t DEFAULT_ENTRIES = size_t(1) << 18;
+
+    /**
+     * @brief Constructor for TranspositionTable
+     * @param entries Number of slots (rounded down to a power of two)
+     */
+    explicit TranspositionTable(size_t entries = DEFAULT_ENTRIES);
+
+    /**
+     * @brief Look up a position
+     * @param key The position's hash
+     * @param entry Receives the stored result on a hit
+     * @return True on a hit
+     */
+    bool probe(uint64_t key, TableEntry& entry) const;
+
+    /**
+     * @brief Store a search result, keeping deeper results from the current search
+     * @param key The position's hash
+     * @param entry The result to store
+     */
+    void store(uint64_t key, const TableEntry& entry);
+
+    /**
+     * @brief Start a new search; results of older searches become replaceable
+     */
+    void newSearch();
+
+    /**
+     * @brief Empty the table and reset the statistics
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of slots
+     * @return Slot count
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the fraction of probes that found their position
+     * @return Hit rate between 0 and 1
+     */
+    double hitRate() const;
+
+    /**
+     * @brief Get the number of lookups since the last clear
+     * @return Probe count
+     */
+    uint64_t getProbes() const;
+
+    /**
+     * @brief Get the number of successful lookups since the last clear
+     * @return Hit count
+     */
+    uint64_t getHits() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;    // key ^ data
+        std::atomic<uint64_t> data;     // Packed TableEntry
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<uint8_t> generation;
+    mutable std::atomic<uint64_t> probes;
+    mutable std::atomic<uint64_t> hits;
+};
+
+#endif // TRANSPOSITION_TABLE_H
\ No newline at end of file
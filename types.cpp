@@ -56,71 +56,6 @@ PokemonType stringToType(const std::string& typeStr) {
     return (it != stringMap.end()) ? it->second : PokemonType::NONE;
 }
 
-// Type effectiveness chart implementation
-float getTypeEffectiveness(PokemonType attackType, PokemonType defenderType) {
-    // Simplified type effectiveness chart
-    static const std::map<PokemonType, std::map<PokemonType, float>> effectivenessChart = {
-        {PokemonType::NORMAL, {
-            {PokemonType::ROCK, 0.5f},
-            {PokemonType::GHOST, 0.0f},
-            {PokemonType::STEEL, 0.5f}
-        }},
-        {PokemonType::FIRE, {
-            {PokemonType::FIRE, 0.5f},
-            {PokemonType::WATER, 0.5f},
-            {PokemonType::GRASS, 2.0f},
-            {PokemonType::ICE, 2.0f},
-            {PokemonType::BUG, 2.0f},
-            {PokemonType::ROCK, 0.5f},
-            {PokemonType::DRAGON, 0.5f},
-            {PokemonType::STEEL, 2.0f}
-        }},
-        {PokemonType::WATER, {
-            {PokemonType::FIRE, 2.0f},
-            {PokemonType::WATER, 0.5f},
-            {PokemonType::GRASS, 0.5f},
-            {PokemonType::GROUND, 2.0f},
-            {PokemonType::ROCK, 2.0f},
-            {PokemonType::DRAGON, 0.5f}
-        }},
-        {PokemonType::ELECTRIC, {
-            {PokemonType::WATER, 2.0f},
-            {PokemonType::ELECTRIC, 0.5f},
-            {PokemonType::GRASS, 0.5f},
-            {PokemonType::GROUND, 0.0f},
-            {PokemonType::FLYING, 2.0f},
-            {PokemonType::DRAGON, 0.5f}
-        }},
-        {PokemonType::GRASS, {
-            {PokemonType::FIRE, 0.5f},
-            {PokemonType::WATER, 2.0f},
-            {PokemonType::GRASS, 0.5f},
-            {PokemonType::POISON, 0.5f},
-            {PokemonType::GROUND, 2.0f},
-            {PokemonType::FLYING, 0.5f},
-            {PokemonType::BUG, 0.5f},
-            {PokemonType::ROCK, 2.0f},
-            {PokemonType::DRAGON, 0.5f},
-            {PokemonType::STEEL, 0.5f}
-        }}
-        // More types would be added here
-    };
-    
-    // Default effectiveness is 1.0 (normal damage)
-    float effectiveness = 1.0f;
-    
-    // Check if we have a specific effectiveness defined
-    auto attackIter = effectivenessChart.find(attackType);
-    if (attackIter != effectivenessChart.end()) {
-        auto defenderIter = attackIter->second.find(defenderType);
-        if (defenderIter != attackIter->second.end()) {
-            effectiveness = defenderIter->second;
-        }
-    }
-    
-    return effectiveness;
-}
-
 // Get ANSI color codes for console output based on type
 std::string getTypeColor(PokemonType type) {
     // ANSI color codes for console output
@@ -44,13 +44,177 @@ std::string typeToString(PokemonType type);
  */
 PokemonType stringToType(const std::string& typeStr);
 
+/**
+ * @brief Number of PokemonType values (including NONE)
+ */
+constexpr int TYPE_COUNT = static_cast<int>(PokemonType::NONE) + 1;
+
+/**
+ * @brief Dense type chart indexed by [attacking type][defending type]
+ */
+struct TypeChart {
+    float multipliers[TYPE_COUNT][TYPE_COUNT];
+};
+
+/**
+ * @brief Builds the full 18-type chart at compile time
+ * @return Type chart where NONE is neutral in both directions
+ */
+constexpr TypeChart makeTypeChart() {
+    struct Entry {
+        PokemonType attack;
+        PokemonType defend;
+        float multiplier;
+    };
+    
+    using T = PokemonType;
+    constexpr Entry entries[] = {
+        {T::NORMAL, T::ROCK, 0.5f}, {T::NORMAL, T::GHOST, 0.0f}, {T::NORMAL, T::STEEL, 0.5f},
+        
+        {T::FIRE, T::FIRE, 0.5f}, {T::FIRE, T::WATER, 0.5f}, {T::FIRE, T::GRASS, 2.0f},
+        {T::FIRE, T::ICE, 2.0f}, {T::FIRE, T::BUG, 2.0f}, {T::FIRE, T::ROCK, 0.5f},
+        {T::FIRE, T::DRAGON, 0.5f}, {T::FIRE, T::STEEL, 2.0f},
+        
+        {T::WATER, T::FIRE, 2.0f}, {T::WATER, T::WATER, 0.5f}, {T::WATER, T::GRASS, 0.5f},
+        {T::WATER, T::GROUND, 2.0f}, {T::WATER, T::ROCK, 2.0f}, {T::WATER, T::DRAGON, 0.5f},
+        
+        {T::GRASS, T::FIRE, 0.5f}, {T::GRASS, T::WATER, 2.0f}, {T::GRASS, T::GRASS, 0.5f},
+        {T::GRASS, T::POISON, 0.5f}, {T::GRASS, T::GROUND, 2.0f}, {T::GRASS, T::FLYING, 0.5f},
+        {T::GRASS, T::BUG, 0.5f}, {T::GRASS, T::ROCK, 2.0f}, {T::GRASS, T::DRAGON, 0.5f},
+        {T::GRASS, T::STEEL, 0.5f},
+        
+        {T::ELECTRIC, T::WATER, 2.0f}, {T::ELECTRIC, T::ELECTRIC, 0.5f}, {T::ELECTRIC, T::GRASS, 0.5f},
+        {T::ELECTRIC, T::GROUND, 0.0f}, {T::ELECTRIC, T::FLYING, 2.0f}, {T::ELECTRIC, T::DRAGON, 0.5f},
+        
+        {T::ICE, T::FIRE, 0.5f}, {T::ICE, T::WATER, 0.5f}, {T::ICE, T::GRASS, 2.0f},
+        {T::ICE, T::ICE, 0.5f}, {T::ICE, T::GROUND, 2.0f}, {T::ICE, T::FLYING, 2.0f},
+        {T::ICE, T::DRAGON, 2.0f}, {T::ICE, T::STEEL, 0.5f},
+        
+        {T::FIGHTING, T::NORMAL, 2.0f}, {T::FIGHTING, T::ICE, 2.0f}, {T::FIGHTING, T::POISON, 0.5f},
+        {T::FIGHTING, T::FLYING, 0.5f}, {T::FIGHTING, T::PSYCHIC, 0.5f}, {T::FIGHTING, T::BUG, 0.5f},
+        {T::FIGHTING, T::ROCK, 2.0f}, {T::FIGHTING, T::GHOST, 0.0f}, {T::FIGHTING, T::DARK, 2.0f},
+        {T::FIGHTING, T::STEEL, 2.0f}, {T::FIGHTING, T::FAIRY, 0.5f},
+        
+        {T::POISON, T::GRASS, 2.0f}, {T::POISON, T::POISON, 0.5f}, {T::POISON, T::GROUND, 0.5f},
+        {T::POISON, T::ROCK, 0.5f}, {T::POISON, T::GHOST, 0.5f}, {T::POISON, T::STEEL, 0.0f},
+        {T::POISON, T::FAIRY, 2.0f},
+        
+        {T::GROUND, T::FIRE, 2.0f}, {T::GROUND, T::ELECTRIC, 2.0f}, {T::GROUND, T::GRASS, 0.5f},
+        {T::GROUND, T::POISON, 2.0f}, {T::GROUND, T::FLYING, 0.0f}, {T::GROUND, T::BUG, 0.5f},
+        {T::GROUND, T::ROCK, 2.0f}, {T::GROUND, T::STEEL, 2.0f},
+        
+        {T::FLYING, T::ELECTRIC, 0.5f}, {T::FLYING, T::GRASS, 2.0f}, {T::FLYING, T::FIGHTING, 2.0f},
+        {T::FLYING, T::BUG, 2.0f}, {T::FLYING, T::ROCK, 0.5f}, {T::FLYING, T::STEEL, 0.5f},
+        
+        {T::PSYCHIC, T::FIGHTING, 2.0f}, {T::PSYCHIC, T::POISON, 2.0f}, {T::PSYCHIC, T::PSYCHIC, 0.5f},
+        {T::PSYCHIC, T::DARK, 0.0f}, {T::PSYCHIC, T::STEEL, 0.5f},
+        
+        {T::BUG, T::FIRE, 0.5f}, {T::BUG, T::GRASS, 2.0f}, {T::BUG, T::FIGHTING, 0.5f},
+        {T::BUG, T::POISON, 0.5f}, {T::BUG, T::FLYING, 0.5f}, {T::BUG, T::PSYCHIC, 2.0f},
+        {T::BUG, T::GHOST, 0.5f}, {T::BUG, T::DARK, 2.0f}, {T::BUG, T::STEEL, 0.5f},
+        {T::BUG, T::FAIRY, 0.5f},
+        
+        {T::ROCK, T::FIRE, 2.0f}, {T::ROCK, T::ICE, 2.0f}, {T::ROCK, T::FIGHTING, 0.5f},
+        {T::ROCK, T::GROUND, 0.5f}, {T::ROCK, T::FLYING, 2.0f}, {T::ROCK, T::BUG, 2.0f},
+        {T::ROCK, T::STEEL, 0.5f},
+        
+        {T::GHOST, T::NORMAL, 0.0f}, {T::GHOST, T::PSYCHIC, 2.0f}, {T::GHOST, T::GHOST, 2.0f},
+        {T::GHOST, T::DARK, 0.5f},
+        
+        {T::DRAGON, T::DRAGON, 2.0f}, {T::DRAGON, T::STEEL, 0.5f}, {T::DRAGON, T::FAIRY, 0.0f},
+        
+        {T::DARK, T::FIGHTING, 0.5f}, {T::DARK, T::PSYCHIC, 2.0f}, {T::DARK, T::GHOST, 2.0f},
+        {T::DARK, T::DARK, 0.5f}, {T::DARK, T::FAIRY, 0.5f},
+        
+        {T::STEEL, T::FIRE, 0.5f}, {T::STEEL, T::WATER, 0.5f}, {T::STEEL, T::ELECTRIC, 0.5f},
+        {T::STEEL, T::ICE, 2.0f}, {T::STEEL, T::ROCK, 2.0f}, {T::STEEL, T::STEEL, 0.5f},
+        {T::STEEL, T::FAIRY, 2.0f},
+        
+        {T::FAIRY, T::FIRE, 0.5f}, {T::FAIRY, T::FIGHTING, 2.0f}, {T::FAIRY, T::POISON, 0.5f},
+        {T::FAIRY, T::DRAGON, 2.0f}, {T::FAIRY, T::DARK, 2.0f}, {T::FAIRY, T::STEEL, 0.5f}
+    };
+    
+    TypeChart chart{};
+    for (int attack = 0; attack < TYPE_COUNT; ++attack) {
+        for (int defend = 0; defend < TYPE_COUNT; ++defend) {
+            chart.multipliers[attack][defend] = 1.0f;
+        }
+    }
+    for (const Entry& entry : entries) {
+        chart.multipliers[static_cast<int>(entry.attack)][static_cast<int>(entry.defend)] = entry.multiplier;
+    }
+    return chart;
+}
+
+/**
+ * @brief The type chart, built at compile time
+ */
+inline constexpr TypeChart TYPE_CHART = makeTypeChart();
+
 /**
  * @brief Gets the type effectiveness multiplier
  * @param attackType The attacking move's type
- * @param defenderType The defending Pokemon's type
+ * @param defenderType The defending Pokemon's type (NONE is always neutral)
  * @return Damage multiplier (0.5 = not effective, 1.0 = normal, 2.0 = super effective)
  */
-float getTypeEffectiveness(PokemonType attackType, PokemonType defenderType);
+constexpr float getTypeEffectiveness(PokemonType attackType, PokemonType defenderType) {
+    return TYPE_CHART.multipliers[static_cast<int>(attackType)][static_cast<int>(defenderType)];
+}
+
+static_assert(getTypeEffectiveness(PokemonType::GROUND, PokemonType::FLYING) == 0.0f, "Type chart is miswired");
+static_assert(getTypeEffectiveness(PokemonType::FAIRY, PokemonType::DRAGON) == 2.0f, "Type chart is miswired");
+static_assert(getTypeEffectiveness(PokemonType::FIRE, PokemonType::NONE) == 1.0f, "NONE must be neutral");
+
+/**
+ * @brief Attacking multipliers against one (primary, secondary) type combination
+ */
+struct DefensiveProfile {
+    float multipliers[TYPE_COUNT];  // Indexed by attacking type
+};
+
+/**
+ * @brief Defensive profiles for every (primary, secondary) type pair
+ */
+struct DefensiveProfileTable {
+    DefensiveProfile profiles[TYPE_COUNT][TYPE_COUNT];
+};
+
+/**
+ * @brief Precomputes the combined multipliers of every type pair at compile time
+ * @return Table indexed by [primary type][secondary type]
+ */
+constexpr DefensiveProfileTable makeDefensiveProfiles() {
+    DefensiveProfileTable table{};
+    for (int primary = 0; primary < TYPE_COUNT; ++primary) {
+        for (int secondary = 0; secondary < TYPE_COUNT; ++secondary) {
+            // A repeated type only counts once
+            int second = (secondary == primary) ? static_cast<int>(PokemonType::NONE) : secondary;
+            for (int attack = 0; attack < TYPE_COUNT; ++attack) {
+                table.profiles[primary][secondary].multipliers[attack] =
+                    TYPE_CHART.multipliers[attack][primary] * TYPE_CHART.multipliers[attack][second];
+            }
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief The defensive profiles, built at compile time
+ */
+inline constexpr DefensiveProfileTable DEFENSIVE_PROFILES = makeDefensiveProfiles();
+
+/**
+ * @brief Gets the defensive profile of a type combination
+ * @param primaryType The defender's primary type
+ * @param secondaryType The defender's secondary type (NONE for single-typed)
+ * @return Profile holding the final multiplier for every attacking type
+ */
+constexpr const DefensiveProfile& getDefensiveProfile(PokemonType primaryType, PokemonType secondaryType) {
+    return DEFENSIVE_PROFILES.profiles[static_cast<int>(primaryType)][static_cast<int>(secondaryType)];
+}
+
+static_assert(getDefensiveProfile(PokemonType::WATER, PokemonType::GROUND).multipliers[static_cast<int>(PokemonType::GRASS)] == 4.0f,
+              "Dual-type profiles must multiply both types");
 
 /**
  * @brief Gets a color code for console output based on Pokemon type
@@ -0,0 +1,206 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+#include "status.h"
+#include "stats.h"
+#include "environment.h"
+
+/**
+ * @brief Sizes of the Zobrist key tables
+ */
+constexpr int ZOBRIST_SIDES = 2;
+constexpr int ZOBRIST_SLOTS = 6;
+constexpr int ZOBRIST_MOVES = 4;
+constexpr int ZOBRIST_STATUS_COUNT = static_cast<int>(StatusEffect::CONFUSION) + 1;
+constexpr int ZOBRIST_ENVIRONMENT_COUNT = static_cast<int>(BattleEnvironment::PSYCHIC_TERRAIN) + 1;
+constexpr int ZOBRIST_TO_MOVE_COUNT = 3;   // Faster side to move, or the second mover after either side
+
+/**
+ * @brief SplitMix64 finalizer; scrambles a 64-bit value into a well-mixed key
+ * @param x The value to mix
+ * @return The mixed value
+ */
+constexpr uint64_t zobristMix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Random keys for every hashed feature of a battle state
+ */
+struct ZobristTable {
+    uint64_t status[ZOBRIST_SIDES][ZOBRIST_SLOTS][ZOBRIST_STATUS_COUNT];
+    uint64_t active[ZOBRIST_SIDES][ZOBRIST_SLOTS];
+    uint64_t stages[ZOBRIST_SIDES][ZOBRIST_SLOTS][STAT_COUNT][STAT_STAGE_COUNT];
+    uint64_t hpSeed[ZOBRIST_SIDES][ZOBRIST_SLOTS];  // HP is hashed as zobristMix(hpSeed + hp) instead of a table per value
+    uint64_t environment[ZOBRIST_ENVIRONMENT_COUNT];
+    uint64_t toMove[ZOBRIST_TO_MOVE_COUNT];
+    uint64_t memberSeed[ZOBRIST_SIDES][ZOBRIST_SLOTS];  // Which team member sits in a slot, hashed like HP
+    uint64_t speciesSeed[ZOBRIST_SIDES][ZOBRIST_SLOTS];
+    uint64_t moveSeed[ZOBRIST_SIDES][ZOBRIST_SLOTS][ZOBRIST_MOVES];
+    uint64_t ppSeed[ZOBRIST_SIDES][ZOBRIST_SLOTS][ZOBRIST_MOVES];
+};
+
+/**
+ * @brief Builds the key tables from a fixed seed so hashes are stable between runs
+ * @return The filled table
+ */
+constexpr ZobristTable makeZobristTable() {
+    ZobristTable table{};
+    uint64_t counter = 0x5A0B1E57ULL;
+    auto next = [&counter]() {
+        counter += 0x9E3779B97F4A7C15ULL;
+        return zobristMix(counter);
+    };
+
+    for (int side = 0; side < ZOBRIST_SIDES; ++side) {
+        for (int slot = 0; slot < ZOBRIST_SLOTS; ++slot) {
+            // NONE hashes to zero so healthy Pokemon don't need a key
+            for (int status = 1; status < ZOBRIST_STATUS_COUNT; ++status) {
+                table.status[side][slot][status] = next();
+            }
+            table.active[side][slot] = next();
+            for (int stat = 0; stat < STAT_COUNT; ++stat) {
+                for (int stage = 0; stage < STAT_STAGE_COUNT; ++stage) {
+                    // Stage 0 hashes to zero as well
+                    table.stages[side][slot][stat][stage] = stage == -MIN_STAT_STAGE ? 0 : next();
+                }
+            }
+            table.hpSeed[side][slot] = next();
+        }
+    }
+    for (int environment = 0; environment < ZOBRIST_ENVIRONMENT_COUNT; ++environment) {
+        table.environment[environment] = next();
+    }
+    for (int toMove = 0; toMove < ZOBRIST_TO_MOVE_COUNT; ++toMove) {
+        table.toMove[toMove] = next();
+    }
+    for (int side = 0; side < ZOBRIST_SIDES; ++side) {
+        for (int slot = 0; slot < ZOBRIST_SLOTS; ++slot) {
+            table.memberSeed[side][slot] = next();
+            table.speciesSeed[side][slot] = next();
+            for (int move = 0; move < ZOBRIST_MOVES; ++move) {
+                table.moveSeed[side][slot][move] = next();
+                table.ppSeed[side][slot][move] = next();
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr ZobristTable ZOBRIST_KEYS = makeZobristTable();
+
+/**
+ * @brief Key of a slot's HP value
+ * @param side Side index
+ * @param slot Team slot
+ * @param hp Current HP
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristHp(int side, int slot, int hp) {
+    return zobristMix(ZOBRIST_KEYS.hpSeed[side][slot] + static_cast<uint64_t>(hp) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Key of the team member sitting in a slot (switching reorders the line-up)
+ * @param side Side index
+ * @param slot Team slot
+ * @param member Index of the member in the team the search was built from
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristMember(int side, int slot, int member) {
+    return zobristMix(ZOBRIST_KEYS.memberSeed[side][slot] + static_cast<uint64_t>(member) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Key of the species in a slot
+ * @param side Side index
+ * @param slot Team slot
+ * @param species The species' ID
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristSpecies(int side, int slot, uint16_t species) {
+    return zobristMix(ZOBRIST_KEYS.speciesSeed[side][slot] + static_cast<uint64_t>(species) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Key of one of a slot's moves
+ * @param side Side index
+ * @param slot Team slot
+ * @param index Index of the move (0..3)
+ * @param move The move's ID
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristMove(int side, int slot, int index, uint16_t move) {
+    return zobristMix(ZOBRIST_KEYS.moveSeed[side][slot][index] + static_cast<uint64_t>(move) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Key of the PP left on one of a slot's moves
+ * @param side Side index
+ * @param slot Team slot
+ * @param index Index of the move (0..3)
+ * @param pp Remaining PP
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristPp(int side, int slot, int index, int pp) {
+    return zobristMix(ZOBRIST_KEYS.ppSeed[side][slot][index] + static_cast<uint64_t>(pp) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**
+ * @brief Key of a slot's status
+ * @param side Side index
+ * @param slot Team slot
+ * @param status Current status (NONE hashes to zero)
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristStatus(int side, int slot, StatusEffect status) {
+    return ZOBRIST_KEYS.status[side][slot][static_cast<int>(status)];
+}
+
+/**
+ * @brief Key of a slot's stat stage
+ * @param side Side index
+ * @param slot Team slot
+ * @param stat The stat
+ * @param stage Current stage (0 hashes to zero)
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristStage(int side, int slot, Stat stat, int stage) {
+    return ZOBRIST_KEYS.stages[side][slot][static_cast<int>(stat)][clampStatStage(stage) - MIN_STAT_STAGE];
+}
+
+/**
+ * @brief Key of a side's active slot
+ * @param side Side index
+ * @param slot Active team slot
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristActive(int side, int slot) {
+    return ZOBRIST_KEYS.active[side][slot];
+}
+
+/**
+ * @brief Key of the battle environment
+ * @param environment The environment
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristEnvironment(BattleEnvironment environment) {
+    return ZOBRIST_KEYS.environment[static_cast<int>(environment)];
+}
+
+/**
+ * @brief Key of whose step it is
+ * @param toMove 0 when the faster side moves next, 1 + first mover's side index when the second mover is next
+ * @return The key to XOR into the hash
+ */
+constexpr uint64_t zobristToMove(int toMove) {
+    return ZOBRIST_KEYS.toMove[toMove];
+}
+
+static_assert(ZOBRIST_KEYS.status[0][0][0] == 0, "healthy Pokemon must not change the hash");
+static_assert(zobristStage(1, 5, Stat::EVASION, 0) == 0, "neutral stages must not change the hash");
+
+#endif // ZOBRIST_H
\ No newline at end of file